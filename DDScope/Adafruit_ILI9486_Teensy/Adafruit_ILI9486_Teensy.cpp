@@ -19,6 +19,8 @@
 #include "../display/Display.h"
 #include "../display/UsbBridge.h"
 #include "../display/WiFiDisplay.h"
+#include "../display/PalettePlane.h"
+#include "../display/DrawRecorder.h"
 #include "miniz.h"
 #include <Adafruit_GFX.h>
 #include <SD.h>
@@ -32,7 +34,7 @@
 uint8_t useDMA = 0;
 
 #ifdef ENABLE_TFT_MIRROR
-static int windowX0, windowY0, windowX1, windowY1;
+static uint16_t windowX0, windowY0, windowX1, windowY1;
 static uint16_t mirror_x = 0;
 static uint16_t mirror_y = 0;
 #endif
@@ -47,55 +49,85 @@ Adafruit_ILI9486_Teensy::Adafruit_ILI9486_Teensy(void)
 // ==================== Set Address Window (Modified) ====================
 void WifiDisplay::captureSetAddrWindow(uint16_t x0, uint16_t y0,
                                        uint16_t x1, uint16_t y1) {
+  // fillScreen() sends a window one past the edges
+  if (x1 >= SCREEN_WIDTH) x1 = SCREEN_WIDTH - 1;
+  if (y1 >= SCREEN_HEIGHT) y1 = SCREEN_HEIGHT - 1;
   windowX0 = x0;
   windowY0 = y0;
   windowX1 = x1;
   windowY1 = y1;
 }
 
-void Adafruit_ILI9486_Teensy::writedata16(uint16_t c) {
-  CD_DATA;
-  CS_ACTIVE;
-
-// #ifdef ENABLE_TFT_MIRROR
-//   if (windowX0 < SCREEN_WIDTH && windowY0 < SCREEN_HEIGHT) {
-//     int index = (windowY0 * SCREEN_WIDTH + windowX0) * COLOR_DEPTH;
-//     uint8_t high = c >> 8;
-//     uint8_t low = c & 0xFF;
-
-//     if (wifiDisplay.isScreenCaptureEnabled) {
-//       uncompressedBuffer[index] = high;
-//       uncompressedBuffer[index + 1] = low;
-//     }
-//   }
-// #endif
 #ifdef ENABLE_TFT_MIRROR
-  //static uint16_t mirror_x = 0;
-  //static uint16_t mirror_y = 0;
+// ==================== Span Capture ====================
+// Pixels go into the capture buffer a row span at a time, following the
+// address window like the panel does. The buffer is big-endian RGB565 (the
+// format sent to the ESP32-S3), so a span is filled with 32-bit words of two
+// byte-swapped pixels rather than byte by byte.
+
+// Length of the span from the cursor to the end of the window row, 0 when
+// the cursor has left the window
+static inline uint32_t captureSpan(uint32_t num) {
+  if (mirror_y > windowY1 || mirror_x > windowX1 || windowX0 > windowX1) return 0;
+  uint32_t span = windowX1 - mirror_x + 1;
+  return (span < num) ? span : num;
+}
 
-  if (wifiDisplay.isScreenCaptureEnabled) {
-    if (windowX0 < SCREEN_WIDTH && windowY0 < SCREEN_HEIGHT) {
-      int index = (mirror_y * SCREEN_WIDTH + mirror_x) * COLOR_DEPTH;
-      uint8_t high = c >> 8;
-      uint8_t low = c & 0xFF;
-
-      if (index + 1 < SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH) {
-         delayMicroseconds(1);  // or tasks.yield(1)
-        uncompressedBuffer[index] = high;
-        uncompressedBuffer[index + 1] = low;
-      }
-    }
+static inline void captureAdvance(uint32_t span) {
+  mirror_x += span;
+  if (mirror_x > windowX1) {
+    mirror_x = windowX0;
+    mirror_y++;
+  }
+}
 
-    // Advance draw position
-    mirror_x++;
-    if (mirror_x > windowX1) {
-      mirror_x = windowX0;
-      mirror_y++;
-      if (mirror_y > windowY1) {
-        mirror_y = windowY0;
-      }
+static void captureFill(uint16_t c, uint32_t num) {
+  uint16_t be = __builtin_bswap16(c);
+  uint32_t word = be | ((uint32_t)be << 16);
+  uint32_t span;
+  while ((span = captureSpan(num)) != 0) {
+    uint16_t *dst = (uint16_t *)(captureBuffer + (mirror_y * SCREEN_WIDTH + mirror_x) * COLOR_DEPTH);
+    uint32_t n = span;
+    if (((uintptr_t)dst & 2) && n) { *dst++ = be; n--; }
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (; n >= 2; n -= 2) *dst32++ = word;
+    if (n) *(uint16_t *)dst32 = be;
+    captureAdvance(span);
+    num -= span;
+  }
+}
+
+static void capturePixels(const uint16_t *pixels, uint32_t num) {
+  uint32_t span;
+  while ((span = captureSpan(num)) != 0) {
+    uint16_t *dst = (uint16_t *)(captureBuffer + (mirror_y * SCREEN_WIDTH + mirror_x) * COLOR_DEPTH);
+    uint32_t n = span;
+    if (((uintptr_t)dst & 2) && n) { *dst++ = __builtin_bswap16(*pixels++); n--; }
+    uint32_t *dst32 = (uint32_t *)dst;
+    for (; n >= 2; n -= 2) {
+      uint32_t two = pixels[0] | ((uint32_t)pixels[1] << 16);
+      *dst32++ = ((two & 0x00FF00FF) << 8) | ((two >> 8) & 0x00FF00FF); // rev16
+      pixels += 2;
     }
+    if (n) *(uint16_t *)dst32 = __builtin_bswap16(*pixels++);
+    captureAdvance(span);
+    num -= span;
   }
+}
+#endif
+
+void Adafruit_ILI9486_Teensy::writedata16(uint16_t c) {
+  CD_DATA;
+  CS_ACTIVE;
+
+#ifdef ENABLE_TFT_DRAWCMDS
+  if (wifiDisplay.isScreenCaptureEnabled) drawRecorder.fill(mirror_x, mirror_y, 1, 1, c);
+#endif
+#ifdef ENABLE_TFT_MIRROR
+  if (wifiDisplay.isScreenCaptureEnabled) captureFill(c, 1);
+#endif
+#ifdef ENABLE_TFT_PALETTE
+  palettePlane.push(c);
 #endif
 
   SPI.transfer(c >> 8);
@@ -108,41 +140,49 @@ void Adafruit_ILI9486_Teensy::writedata16(uint16_t c, uint32_t num) {
   CD_DATA;
   CS_ACTIVE;
 
+#ifdef ENABLE_TFT_DRAWCMDS
+  // every fill the driver does covers its whole window
+  if (wifiDisplay.isScreenCaptureEnabled) {
+    int16_t w = windowX1 - windowX0 + 1, h = windowY1 - windowY0 + 1;
+    if (mirror_x == windowX0 && mirror_y == windowY0 && num >= (uint32_t)w * h)
+      drawRecorder.fill(windowX0, windowY0, w, h, c);
+    else
+      drawRecorder.pixels(windowX0, windowY0, w, h);
+  }
+#endif
 #ifdef ENABLE_TFT_MIRROR
-  uint8_t highByte = c >> 8;
-  uint8_t lowByte = c & 0xFF;
-
-  uint32_t pixelCount = 0;
-  int x = windowX0;
-  int y = windowY0;
+  if (wifiDisplay.isScreenCaptureEnabled) captureFill(c, num);
+#endif
+#ifdef ENABLE_TFT_PALETTE
+  palettePlane.pushFill(c, num);
+#endif
 
-  while (pixelCount < num) {
-    if (x >= SCREEN_WIDTH) {
-      x = 0;
-      y++;
-    }
-    if (y >= SCREEN_HEIGHT)
-      break;
+  for (uint32_t i = 0; i < num; i++) {
+    SPI.transfer(c >> 8);
+    SPI.transfer(c & 0xFF);
+  }
 
-    int index = (y * SCREEN_WIDTH + x) * COLOR_DEPTH;
+  CS_IDLE;
+}
 
-    if (wifiDisplay.isScreenCaptureEnabled) {
-      uncompressedBuffer[index] = highByte;
-      uncompressedBuffer[index + 1] = lowByte;
-    }
+// write multiple pixels of different colors, window already set
+void Adafruit_ILI9486_Teensy::writePixels(const uint16_t *pixels, uint32_t num) {
+  CD_DATA;
+  CS_ACTIVE;
 
-    pixelCount++;
-    x++;
-    if (x > windowX1) {
-      x = windowX0;
-      y++;
-    }
-  }
+#ifdef ENABLE_TFT_DRAWCMDS
+  if (wifiDisplay.isScreenCaptureEnabled)
+    drawRecorder.pixels(windowX0, windowY0, windowX1 - windowX0 + 1, windowY1 - windowY0 + 1);
+#endif
+#ifdef ENABLE_TFT_MIRROR
+  if (wifiDisplay.isScreenCaptureEnabled) capturePixels(pixels, num);
+#endif
+#ifdef ENABLE_TFT_PALETTE
+  palettePlane.pushPixels(pixels, num);
 #endif
 
   for (uint32_t i = 0; i < num; i++) {
-    SPI.transfer(c >> 8);
-    SPI.transfer(c & 0xFF);
+    SPI.transfer16(pixels[i]);
   }
 
   CS_IDLE;
@@ -256,8 +296,21 @@ void Adafruit_ILI9486_Teensy::setAddrWindow(uint16_t x0, uint16_t y0,
   wifiDisplay.captureSetAddrWindow(x0, y0, x1, y1); // Store window area for capture
   mirror_x = x0;
   mirror_y = y0;
+  if (wifiDisplay.isScreenCaptureEnabled) wifiDisplay.markDirty(x0, y0, x1, y1);
+#endif
+#ifdef ENABLE_TFT_PALETTE
+  palettePlane.window(x0, y0, x1, y1);
 
 #endif
+  // capture and palette keep screen rows, the panel gets the scrolled rows.
+  // Callers split windows that wrap in the scroll area, only fillScreen()
+  // sends one whole and a single color doesn't care about the row order.
+  if (scrollOffset && panelRun(y0, y1 - y0 + 1) > y1 - y0) {
+    uint16_t h = y1 - y0;
+    y0 = panelRow(y0);
+    y1 = y0 + h;
+  }
+
   writecommand(ILI9486_CASET); // Column addr set
   writedata(x0 >> 8);
   writedata(x0 & 0xFF); // XSTART
@@ -299,10 +352,15 @@ void Adafruit_ILI9486_Teensy::drawFastVLine(int16_t x, int16_t y, int16_t h,
     return;
   }
 
-  setAddrWindow(x, y, x, y + h - 1);
-  SPI.beginTransaction(SPISET);
-  writedata16(color, h);
-  SPI.endTransaction();
+  while (h > 0) {
+    int16_t rows = panelRun(y, h);
+    setAddrWindow(x, y, x, y + rows - 1);
+    SPI.beginTransaction(SPISET);
+    writedata16(color, rows);
+    SPI.endTransaction();
+    y += rows;
+    h -= rows;
+  }
 }
 
 /*****************************************************************************/
@@ -356,11 +414,145 @@ void Adafruit_ILI9486_Teensy::fillRect(int16_t x, int16_t y, int16_t w,
     return;
   }
 
-  setAddrWindow(x, y, x + w - 1, y + h - 1);
+  // one window per run of rows that is contiguous on the panel
+  while (h > 0) {
+    int16_t rows = panelRun(y, h);
+    setAddrWindow(x, y, x + w - 1, y + rows - 1);
+    SPI.beginTransaction(SPISET);
+    writecommand(ILI9486_RAMWR);
+    writedata16(color, (w * rows));
+    SPI.endTransaction();
+    y += rows;
+    h -= rows;
+  }
+}
+
+// Block transfer of a w x h RGB565 image in one address window
+// (glyph strips, canvases and sprites), no per pixel windows like drawPixel()
+bool Adafruit_ILI9486_Teensy::writeRect(int16_t x, int16_t y, int16_t w,
+                                        int16_t h, const uint16_t *pixels) {
+  // only whole images, callers compose into a buffer that fits on screen
+  if ((x < 0) || (y < 0) || (w < 1) || (h < 1))
+    return false;
+  if ((x + w - 1) >= _width || (y + h - 1) >= _height)
+    return false;
+
+  while (h > 0) {
+    int16_t rows = panelRun(y, h);
+    setAddrWindow(x, y, x + w - 1, y + rows - 1);
+    SPI.beginTransaction(SPISET);
+    writePixels(pixels, (uint32_t)w * rows);
+    SPI.endTransaction();
+    pixels += (uint32_t)w * rows;
+    y += rows;
+    h -= rows;
+  }
+  return true;
+}
+
+// ==================== Vertical Scrolling ====================
+// The ILI9486 shows the rows of the scroll area starting at VSCRSADD and
+// wrapping around, so moving a list by a row is one command plus drawing
+// the row that comes into view instead of redrawing the whole list.
+
+// Panel row that is currently shown at screen row y
+uint16_t Adafruit_ILI9486_Teensy::panelRow(uint16_t y) {
+  if (y < scrollTop || y >= scrollTop + scrollHeight) return y;
+  uint16_t row = y - scrollTop + scrollOffset;
+  if (row >= scrollHeight) row -= scrollHeight;
+  return scrollTop + row;
+}
+
+// Number of screen rows from y (at most h) that are contiguous on the panel
+int16_t Adafruit_ILI9486_Teensy::panelRun(int16_t y, int16_t h) {
+  if (!scrollOffset) return h;
+  int16_t bottom = scrollTop + scrollHeight;
+  int16_t wrap = bottom - scrollOffset;
+  int16_t end;
+  if (y < scrollTop)   end = scrollTop; else
+  if (y < wrap)        end = wrap; else
+  if (y < bottom)      end = bottom; else
+                       end = _height;
+  return min(h, (int16_t)(end - y));
+}
+
+// Define the scrolling band, rows above and below it stay fixed. The band
+// must be at rest (scrolled a whole number of its heights) when changed.
+void Adafruit_ILI9486_Teensy::setScrollArea(uint16_t top, uint16_t height) {
+  if (top >= TFTHEIGHT) top = 0;
+  if (height == 0 || top + height > TFTHEIGHT) height = TFTHEIGHT - top;
+  scrollTop = top;
+  scrollHeight = height;
+  scrollOffset = 0;
+
+  SPI.beginTransaction(SPISET);
+  writecommand(ILI9486_VSCRDEF);
+  writedata(top >> 8);
+  writedata(top & 0xFF); // top fixed area
+  writedata(height >> 8);
+  writedata(height & 0xFF); // scroll area
+  writedata((TFTHEIGHT - top - height) >> 8);
+  writedata((TFTHEIGHT - top - height) & 0xFF); // bottom fixed area
+
+  writecommand(ILI9486_VSCRSADD);
+  writedata(top >> 8);
+  writedata(top & 0xFF);
+  SPI.endTransaction();
+}
+
+// Move the band content by lines; the rows coming into view keep the pixels
+// that scrolled out and have to be drawn by the caller
+void Adafruit_ILI9486_Teensy::scrollArea(int16_t lines) {
+  if (lines == 0 || abs(lines) >= scrollHeight) return;
+  scrollOffset = (scrollOffset + scrollHeight + lines) % scrollHeight;
+
   SPI.beginTransaction(SPISET);
-  writecommand(ILI9486_RAMWR);
-  writedata16(color, (w * h));
+  writecommand(ILI9486_VSCRSADD);
+  writedata((scrollTop + scrollOffset) >> 8);
+  writedata((scrollTop + scrollOffset) & 0xFF);
   SPI.endTransaction();
+
+#ifdef ENABLE_TFT_MIRROR
+  if (wifiDisplay.isScreenCaptureEnabled) {
+    uint32_t rowBytes = SCREEN_WIDTH * COLOR_DEPTH;
+    uint8_t* band = captureBuffer + scrollTop * rowBytes;
+    uint32_t n = abs(lines);
+    if (lines > 0)
+      memmove(band, band + n * rowBytes, (scrollHeight - n) * rowBytes);
+    else
+      memmove(band + n * rowBytes, band, (scrollHeight - n) * rowBytes);
+    wifiDisplay.markDirty(0, scrollTop, SCREEN_WIDTH - 1, scrollTop + scrollHeight - 1);
+  }
+#endif
+#ifdef ENABLE_TFT_DRAWCMDS
+  if (wifiDisplay.isScreenCaptureEnabled) drawRecorder.scroll(scrollTop, scrollHeight, lines);
+#endif
+#ifdef ENABLE_TFT_PALETTE
+  palettePlane.scroll(scrollTop, scrollHeight, lines);
+#endif
+}
+
+// ==================== Text ====================
+// With the draw command mirror, print() is recorded a character at a time
+// instead of the pixels GFX draws for it
+size_t Adafruit_ILI9486_Teensy::write(uint8_t c) {
+#ifdef ENABLE_TFT_DRAWCMDS
+  if (wifiDisplay.isScreenCaptureEnabled && c != '\n' && c != '\r') {
+    int16_t x = cursor_x, y = cursor_y;
+    drawRecorder.pause();
+    size_t n = Adafruit_GFX::write(c);
+    drawRecorder.resume();
+    // the cursor moved on if something was drawn, from x or from the
+    // start of the next line when the text wrapped
+    if (cursor_x != x || cursor_y != y) {
+      char s = c;
+      drawRecorder.text((cursor_y == y) ? x : 0, cursor_y, gfxFont, textsize_x,
+                        textcolor, textbgcolor, &s, 1, cursor_x);
+    }
+    return n;
+  }
+#endif
+  return Adafruit_GFX::write(c);
 }
 
 /*
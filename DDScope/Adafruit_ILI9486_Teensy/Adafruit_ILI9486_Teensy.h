@@ -26,7 +26,9 @@ extern uint8_t useDMA;
 #define ILI9486_CASET	 0x2A
 #define ILI9486_PASET	 0x2B
 #define ILI9486_RAMWR	 0x2C
+#define ILI9486_VSCRDEF  0x33
 #define ILI9486_MADCTL 0x36
+#define ILI9486_VSCRSADD 0x37
 #define MADCTL_MY  0x80
 #define MADCTL_MX  0x40
 #define MADCTL_MV  0x20
@@ -62,9 +64,24 @@ class Adafruit_ILI9486_Teensy : public Adafruit_GFX
     void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color);
     void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color);
     void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    bool writeRect(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels);
     void setRotation(uint8_t r);
     void invertDisplay(boolean i);
     uint16_t color565(uint8_t r, uint8_t g, uint8_t b);
+
+    // Hardware vertical scrolling of a full width band of rows (rotation 0).
+    // Drawing keeps using screen coordinates, rows inside the band are mapped
+    // to where the panel currently shows them.
+    void setScrollArea(uint16_t top, uint16_t height);
+    void scrollArea(int16_t lines); // > 0 moves the content up, < 0 down
+
+    // current GFX text settings, used to route text through the glyph cache
+    const GFXfont* getFont() { return gfxFont; }
+    uint16_t getTextColor() { return textcolor; }
+
+    // print() goes through here, recorded for the draw command mirror
+    size_t write(uint8_t c);
+    using Print::write;
     
 
  private:
@@ -72,8 +89,14 @@ class Adafruit_ILI9486_Teensy : public Adafruit_GFX
     void writedata(uint8_t d);
     void writedata16(uint16_t d);
     void writedata16(uint16_t d, uint32_t num);
+    void writePixels(const uint16_t *pixels, uint32_t num);
     void commandList(uint8_t *addr);
-    
+    uint16_t panelRow(uint16_t y);
+    int16_t panelRun(int16_t y, int16_t h);
+
+    uint16_t scrollTop = 0;
+    uint16_t scrollHeight = TFTHEIGHT;
+    uint16_t scrollOffset = 0; // band row shown at the top of the band
 };
 
 #endif
@@ -39,14 +39,27 @@
 #include "src/libApp/commands/ProcessCmds.h"
 #include "src/plugins/DDScope/display/UsbBridge.h"
 #include "src/plugins/DDScope/display/WifiDisplay.h"
+#include "src/plugins/DDScope/display/MirrorBench.h"
+#include "src/plugins/DDScope/display/SdWriter.h"
 
 #ifdef ODRIVE_MOTOR_PRESENT
   #include "odriveExt/ODriveExt.h"
 #endif
+#if ODRIVE_COMM_MODE == OD_CAN
+  #include "src/plugins/DDScope/ODriveTeensyCAN/ODriveTeensyCAN.h"
+  #include "src/plugins/DDScope/odriveExt/MotorTelemetry.h"
+#endif
 
-void touchWrapper() { touchScreen.touchScreenPoll(display.currentScreen); }
+void touchWrapper() { touchScreen.touchScreenPoll(); }
 void updateScreenWrapper() { display.updateSpecificScreen(); }
 void espWrapper() { wifiDisplay.espPoll(); }
+void sdWriterWrapper() { sdWriter.poll(); }
+#if ODRIVE_COMM_MODE == OD_CAN
+void canWrapper() { ODriveTeensyCAN::events(); }
+#endif
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+void telemetryWrapper() { motorTelemetry.sample(); }
+#endif
 
 void DDScope::init() {
 
@@ -88,6 +101,14 @@ void DDScope::init() {
   // .begin is done by the constructor
   // in ODriveTeensyCAN.cpp
   VLF("MSG: ODrive, CAN channel init");
+  // Frames from the ODrive go into the telemetry cache from this task
+  VF("MSG: Setup, start ODrive CAN receive task (rate 1 ms priority 2)... ");
+  if (tasks.add(1, 0, true, 2, canWrapper, "CanRx")) { VLF("success"); } else { VLF("FAILED!"); }
+  #ifdef ENABLE_MOTOR_TELEMETRY
+  // Position error, Iq and velocity of both motors for the ODrive screen plot
+  VF("MSG: Setup, start motor telemetry task (rate 10 ms priority 4)... ");
+  if (tasks.add(MOTOR_TELEMETRY_MS, 0, true, 4, telemetryWrapper, "MtrTlm")) { VLF("success"); } else { VLF("FAILED!"); }
+  #endif
 #endif
 
   // Initialize Touchscreen *NOTE: must occur before display.init() since SPI.begin() is done here
@@ -98,6 +119,11 @@ void DDScope::init() {
   VLF("MSG: Display, Initializing");
   display.init();
 
+#ifdef ENABLE_MIRROR_BENCHMARK
+  // codec numbers from the screen captures on the SD card
+  mirrorBenchmark();
+#endif
+
 #ifdef ENABLE_TFT_MIRROR
   // Communication channel between Teensy and ESP32-S3 for WiFi Screen Mirror
   usbBegin();
@@ -111,9 +137,18 @@ void DDScope::init() {
   }
 #endif
 
+#if defined(ENABLE_TFT_CAPTURE) || defined(ENABLE_TFT_RECORDING)
+  // Screen captures and session recordings go to the SD card from this task
+  VF("MSG: Setup, start SD writer task (rate 10 ms priority 6)... ");
+  if (tasks.add(10, 0, true, 6, sdWriterWrapper, "sdWriter")) { VLF("success"); } else { VLF("FAILED!"); }
+#endif
+#ifdef ENABLE_TFT_RECORDING
+  sdWriter.startRecording();
+#endif
+
 // start touchscreen task
-  VF("MSG: Setup, start TouchScreen polling task (rate 333 ms priority 6)... ");
-  uint8_t TShandle = tasks.add(250, 0, true, 3, touchWrapper, "TouchScreen");
+  VF("MSG: Setup, start TouchScreen polling task (rate 5 ms priority 3)... ");
+  uint8_t TShandle = tasks.add(TOUCH_POLL_MS, 0, true, 3, touchWrapper, "TouchScreen");
   if (TShandle) {
     VLF("success");
   } else {
@@ -122,8 +157,9 @@ void DDScope::init() {
   tasks.setTimingMode(TShandle, TM_MINIMUM);
 
   // Update currently selected screen status
-  //   NOTE: this task MUST be a lower priority than the TouchScreen task to prevent
-  //   race conditions that result in the WiFi uncompressedBuffer being overwritten
+  //   NOTE: the WiFi mirror draws into its own capture buffer and compresses the
+  //   other one, so the priority relative to the TouchScreen task is only about
+  //   touch response now
   VF("MSG: Setup, start Screen status update task (rate 1000 ms priority 6)... ");
   uint8_t us_handle = tasks.add(1000, 0, true, 5, updateScreenWrapper, "UpdateSpecificScreen");
   if (us_handle)  { VLF("success"); } else { VLF("FAILED!"); }
@@ -32,18 +32,125 @@ template<>        inline Print& operator <<(Print &obj, float arg) { obj.print(a
 //FlexCAN_T4<CAN0, RX_SIZE_256, TX_SIZE_16> Can0;
 FlexCAN_T4<CAN3, RX_SIZE_256, TX_SIZE_16> Can0;
 
+// Telemetry cache, the last frame of every command ID from each node.
+// The receive interrupt drains the FIFO into the FlexCAN_T4 queue and events()
+// stores the frames here, so a getter only waits on the bus for a value
+// that has never arrived.
+typedef struct CanFrame {
+  uint8_t  buf[8];
+  uint32_t count;      // frames received, 0 if none yet
+  uint32_t rxMs;       // millis() of the last one
+  uint32_t requestMs;  // millis() of the last RTR
+  uint16_t periodMs;   // between unrequested arrivals
+  uint8_t  unasked;    // unrequested arrivals in a row at about periodMs
+  bool     pending;    // RTR sent and not answered yet
+  bool     broadcast;  // arrives without being asked for
+} CanFrame;
+
+static CanFrame cache[ODRIVE_CAN_NODES][32];
+
+static void onFrame(const CAN_message_t &msg) {
+  if (msg.flags.remote) return;
+  uint32_t node = msg.id >> CommandIDLength;
+  uint32_t cmd = msg.id & 0x1F;
+  if (node >= ODRIVE_CAN_NODES) return;
+
+  CanFrame &frame = cache[node][cmd];
+  uint32_t now = millis();
+  if (!frame.pending && frame.count > 0) {
+    // nobody asked for it, the ODrive sends it cyclically once it keeps
+    // coming at a steady period (within a quarter, events() runs every msec)
+    uint16_t period = min(now - frame.rxMs, 0xFFFFUL);
+    bool steady = frame.unasked > 0 && abs((int32_t)period - (int32_t)frame.periodMs) <= frame.periodMs/4 + 2;
+    if (!steady) frame.unasked = 1; else if (frame.unasked < ODRIVE_CAN_BCAST_RX) frame.unasked++;
+    frame.periodMs = period;
+    frame.broadcast = frame.unasked >= ODRIVE_CAN_BCAST_RX;
+  }
+  memcpy(frame.buf, msg.buf, sizeof(frame.buf));
+  frame.rxMs = now;
+  frame.count++;
+  frame.pending = false;
+}
+
+// A broadcast value that hasn't come for ODRIVE_CAN_BCAST_LOST periods has stopped
+static bool broadcasting(CanFrame &frame, uint32_t now) {
+  if (frame.broadcast && now - frame.rxMs > ODRIVE_CAN_BCAST_LOST*(uint32_t)frame.periodMs) {
+    frame.broadcast = false;
+    frame.unasked = 0;
+  }
+  return frame.broadcast;
+}
+
+static float floatAt(const uint8_t *buf, int offset) {
+  float output;
+  memcpy(&output, buf + offset, 4);
+  return output;
+}
+
+static int32_t int32At(const uint8_t *buf, int offset) {
+  int32_t output;
+  memcpy(&output, buf + offset, 4);
+  return output;
+}
+
 ODriveTeensyCAN::ODriveTeensyCAN(int CANBaudRate) {
   this->CANBaudRate = CANBaudRate;
 	Can0.begin();
   Can0.setBaudRate(CANBaudRate);
 
-  // explore using FIFO and interrupts
-  //Can0.setMaxMB(16);
-  //Can0.enableFIFO();
-  //Can0.enableFIFOInterrupt();
-  //Can0.onReceive(canSniff);
+  // receive through the FIFO by interrupt, replies are picked up by events()
+  Can0.setMaxMB(16);
+  Can0.enableFIFO();
+  Can0.enableFIFOInterrupt();
+  Can0.onReceive(onFrame);
   //Can0.mailboxStatus();
 }
+
+void ODriveTeensyCAN::events() {
+  Can0.events();
+}
+
+uint32_t ODriveTeensyCAN::Age(int axis_id, int cmd_id) {
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_NODES || cache[axis_id][cmd_id & 0x1F].count == 0) return 0xFFFFFFFF;
+  return millis() - cache[axis_id][cmd_id & 0x1F].rxMs;
+}
+
+bool ODriveTeensyCAN::IsBroadcast(int axis_id, int cmd_id) {
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_NODES) return false;
+  return broadcasting(cache[axis_id][cmd_id & 0x1F], millis());
+}
+
+// Cached payload of cmd_id from axis_id. A value older than ODRIVE_CAN_MAX_AGE
+// is requested again and the caller gets the last one without waiting, the
+// reply updates the cache when it comes. A value the ODrive broadcasts is only
+// requested if its broadcasts stop, heartbeats are never requested.
+// Only the very first request of a value waits for the reply, up to TIMEOUT.
+const uint8_t* ODriveTeensyCAN::Cached(int axis_id, int cmd_id) {
+  static const uint8_t none[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_NODES) return none;
+
+  CanFrame &frame = cache[axis_id][cmd_id & 0x1F];
+  if (cmd_id == CMD_ID_ODRIVE_HEARTBEAT_MESSAGE) return frame.buf;
+
+  unsigned long now = millis();
+  uint32_t maxAge = ODRIVE_CAN_MAX_AGE;
+  if (broadcasting(frame, now)) maxAge = max(maxAge, ODRIVE_CAN_BCAST_LOST*(uint32_t)frame.periodMs);
+  bool stale = frame.count == 0 || now - frame.rxMs > maxAge;
+  bool waiting = frame.pending && now - frame.requestMs < ODRIVE_CAN_RTR_WAIT;
+  if (!stale || waiting) return frame.buf;
+
+  bool first = frame.count == 0 && frame.requestMs == 0;
+  if (!sendMessage(axis_id, cmd_id, true, 8, NULL)) return frame.buf;
+  if (first) {
+    while (frame.count == 0 && millis() - now < TIMEOUT) Can0.events();
+    if (frame.count == 0) {
+      SERIAL_DEBUG.println("CAN read Timeout");
+      SERIAL_DEBUG.print("Axis ID: 0x"); SERIAL_DEBUG.println(axis_id, HEX);
+      SERIAL_DEBUG.print("Cmd ID: 0x"); SERIAL_DEBUG.println(cmd_id, HEX);
+    }
+  }
+  return frame.buf;
+}
 	
 // ******CAN Frame******
 // At its most basic, the CAN Simple frame looks like this:
@@ -59,58 +166,27 @@ ODriveTeensyCAN::ODriveTeensyCAN(int CANBaudRate) {
 // 0x014  |    Get IQ*     | Axis   | Iq Setpoint Iq Measured|   0 4     | IEEE 754 Float IEEE 754 Float| 32 32|  1 1  | 0 0
 // 0x017  |Get Vbus Voltage| Master | Vbus VoltageIEEE       |     0     | 754 Float                    | 32   |  1    | 0
 
+// An RTR only sends the request, the reply goes to the telemetry cache
 bool ODriveTeensyCAN::sendMessage(int axis_id, int cmd_id, bool remote_transmission_request, int length, byte *signal_bytes) {
   CAN_message_t msg;
-  CAN_message_t return_msg;
 
   msg.id = (axis_id << CommandIDLength) + cmd_id;
   msg.flags.remote = remote_transmission_request;
   msg.len = length;
-  if (!remote_transmission_request) {
-      memcpy(msg.buf, signal_bytes, msg.len);
-      Can0.write(msg);
-      return true;
-  }
-  
-  Can0.write(msg);
-  unsigned long start_time = millis();
-  while (millis() - start_time < TIMEOUT) {
-    if (Can0.read(return_msg) && (return_msg.id == msg.id)) {
-        memcpy(signal_bytes, return_msg.buf, sizeof(return_msg.buf));
-        return true;
-    }
+  if (!remote_transmission_request) memcpy(msg.buf, signal_bytes, msg.len);
+
+  if (Can0.write(msg) <= 0) {
+    SERIAL_DEBUG.println("CAN write failed");
+    SERIAL_DEBUG.print("Axis ID: 0x"); SERIAL_DEBUG.println(axis_id, HEX);
+    SERIAL_DEBUG.print("Cmd ID: 0x"); SERIAL_DEBUG.println(cmd_id, HEX);
+    return false;
   }
-  // Show timeout info
-  SERIAL_DEBUG.println("CAN read Timeout");
-  SERIAL_DEBUG.print("Axis ID: 0x"); SERIAL_DEBUG.println(axis_id, HEX);
-  SERIAL_DEBUG.print("Cmd ID: 0x"); SERIAL_DEBUG.println(cmd_id, HEX);
-  //SERIAL_DEBUG.print("Length: "); SERIAL_DEBUG.println(length);
-  //SERIAL_DEBUG.print("msg.id: 0x"); SERIAL_DEBUG.println(msg.id, HEX);  
-  //SERIAL_DEBUG.print("msg.flags.remote: "); SERIAL_DEBUG.println(msg.flags.remote ? "True" : "False");
-  //SERIAL_DEBUG.print("msg.len: "); SERIAL_DEBUG.println(msg.len);
-  SERIAL_DEBUG.print("signal_bytes: ");
-
-  for (int i = 0; i < length; i++) {
-      SERIAL_DEBUG.print("0x");  // Add prefix
-      if (signal_bytes[i] < 0x10) SERIAL_DEBUG.print("0");  // Ensure leading zero for single-digit hex
-      SERIAL_DEBUG.print(signal_bytes[i], HEX);
-      SERIAL_DEBUG.print(" ");
+
+  if (remote_transmission_request && axis_id >= 0 && axis_id < ODRIVE_CAN_NODES) {
+    cache[axis_id][cmd_id & 0x1F].requestMs = millis();
+    cache[axis_id][cmd_id & 0x1F].pending = true;
   }
-  SERIAL_DEBUG.println(); // New line after printing all bytes
-
-  // Print msg.buf
-  // if (!msg.flags.remote) {
-  //     SERIAL_DEBUG.print("msg.buf: ");
-  //     for (int i = 0; i < msg.len; i++) {
-  //         SERIAL_DEBUG.print("0x");  // Add prefix
-  //         if (msg.buf[i] < 0x10) SERIAL_DEBUG.print("0");  // Ensure leading zero
-  //         SERIAL_DEBUG.print(msg.buf[i], HEX);
-  //         SERIAL_DEBUG.print(" ");
-  //     }
-  //     SERIAL_DEBUG.println();
-  // }
-  return false;
-  //tasks.yield(); // Remove this because it causes lock ups!!!!!
+  return true;
 }
 
 // # 0x001 - Heartbeat 
@@ -119,14 +195,6 @@ bool ODriveTeensyCAN::sendMessage(int axis_id, int cmd_id, bool remote_transmiss
 // motorFlags:      bits 40 - 47, byte 5
 // encoderFlags:    bits 48 - 55, byte 6
 // controllerFlags: bits 56 - 63, byte 7
-int ODriveTeensyCAN::Heartbeat() {
-  CAN_message_t return_msg;
-	if(Can0.read(return_msg) == 1) {
-		return (int)(return_msg.id >> 5);
-	} else {
-		return -1;
-	}
-}
 
 void ODriveTeensyCAN::SetAxisNodeId(int axis_id, int node_id) {
 	byte* node_id_b = (byte*) &node_id;
@@ -287,227 +355,87 @@ void ODriveTeensyCAN::SetVelocityGains(int axis_id, float velocity_gain, float v
 }
 
 //////////// Get functions ///////////
+// All of these return the cached value, see Cached()
 
 float ODriveTeensyCAN::GetPosition(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_ENCODER_ESTIMATES, true, 8, msg_data);
-
-  float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  //SERIAL_DEBUG.println(output);
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_ENCODER_ESTIMATES), 0);
 }
 
 float ODriveTeensyCAN::GetVelocity(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_ENCODER_ESTIMATES, true, 8, msg_data);
-
-  float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[4];
-  *((uint8_t *)(&output) + 1) = msg_data[5];
-  *((uint8_t *)(&output) + 2) = msg_data[6];
-  *((uint8_t *)(&output) + 3) = msg_data[7];
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_ENCODER_ESTIMATES), 4);
 }
 
 int32_t ODriveTeensyCAN::GetEncoderShadowCount(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_ENCODER_COUNT, true, 8, msg_data);
-	
-	int32_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  return int32At(Cached(axis_id, CMD_ID_GET_ENCODER_COUNT), 0);
 }
 
 int32_t ODriveTeensyCAN::GetEncoderCountInCPR(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_ENCODER_COUNT, true, 8, msg_data);
-	
-	int32_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[4];
-  *((uint8_t *)(&output) + 1) = msg_data[5];
-  *((uint8_t *)(&output) + 2) = msg_data[6];
-  *((uint8_t *)(&output) + 3) = msg_data[7];
-  return output;
+  return int32At(Cached(axis_id, CMD_ID_GET_ENCODER_COUNT), 4);
 }
 
 float ODriveTeensyCAN::GetIqSetpoint(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_IQ, true, 8, msg_data);
-	
-	float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_IQ), 0);
 }
 
 float ODriveTeensyCAN::GetIqMeasured(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_IQ, true, 8, msg_data);
-	
-	float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[4];
-  *((uint8_t *)(&output) + 1) = msg_data[5];
-  *((uint8_t *)(&output) + 2) = msg_data[6];
-  *((uint8_t *)(&output) + 3) = msg_data[7];
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_IQ), 4);
 }
 
 float ODriveTeensyCAN::GetSensorlessPosition(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_SENSORLESS_ESTIMATES, true, 8, msg_data);
-	
-	float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_SENSORLESS_ESTIMATES), 0);
 }
 
 float ODriveTeensyCAN::GetSensorlessVelocity(int axis_id) {
-	byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_SENSORLESS_ESTIMATES, true, 8, msg_data);
-	
-	float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[4];
-  *((uint8_t *)(&output) + 1) = msg_data[5];
-  *((uint8_t *)(&output) + 2) = msg_data[6];
-  *((uint8_t *)(&output) + 3) = msg_data[7];
-  return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_SENSORLESS_ESTIMATES), 4);
 }
 
 uint32_t ODriveTeensyCAN::GetMotorError(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_MOTOR_ERROR, true, 4, msg_data);
-
-  uint32_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  return (uint32_t)int32At(Cached(axis_id, CMD_ID_GET_MOTOR_ERROR), 0);
 }
 
 uint32_t ODriveTeensyCAN::GetEncoderError(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  sendMessage(axis_id, CMD_ID_GET_ENCODER_ERROR, true, 4, msg_data);
-
-  uint32_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  return (uint32_t)int32At(Cached(axis_id, CMD_ID_GET_ENCODER_ERROR), 0);
 }
 
+// # 0x001 - Heartbeat, from the cache since the ODrive broadcasts it
 // NOTE: The CAN default Heartbeat is 100 msec. 
 uint32_t ODriveTeensyCAN::GetAxisError(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint32_t output;
-  CAN_message_t return_msg;
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
-
-  while(true) {
-      if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-          memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-          *((uint8_t *)(&output) + 0) = msg_data[0];
-          *((uint8_t *)(&output) + 1) = msg_data[1];
-          *((uint8_t *)(&output) + 2) = msg_data[2];
-          *((uint8_t *)(&output) + 3) = msg_data[3];
-          return output;  // Successfully received message
-      }
-    tasks.yield();
-  }
+  return (uint32_t)int32At(Cached(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE), 0);
 }
 
-uint8_t ODriveTeensyCAN::GetControllerFlags(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t output;
-
-  CAN_message_t return_msg;
+// non-zero if the motor has an error, GetMotorError() has the bits
+uint8_t ODriveTeensyCAN::GetMotorFlags(int axis_id) {
+  return Cached(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE)[5];
+}
 
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
+// non-zero if the encoder has an error, GetEncoderError() has the bits
+uint8_t ODriveTeensyCAN::GetEncoderFlags(int axis_id) {
+  return Cached(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE)[6];
+}
 
-  while (true) {
-    if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-      memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-      *((uint8_t *)(&output) + 0) = msg_data[7];
-      return output;
-    }
-  }
-  tasks.yield();
+uint8_t ODriveTeensyCAN::GetControllerFlags(int axis_id) {
+  return Cached(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE)[7];
 }
 
 uint8_t ODriveTeensyCAN::GetCurrentState(int axis_id) {
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t output;
-
-  CAN_message_t return_msg;
-
-  uint32_t msg_id = (axis_id << CommandIDLength) + CMD_ID_ODRIVE_HEARTBEAT_MESSAGE;
-
-  while (true) {
-    if (Can0.read(return_msg) && (return_msg.id == msg_id)) {
-      memcpy(msg_data, return_msg.buf, sizeof(return_msg.buf));
-      *((uint8_t *)(&output) + 0) = msg_data[4];
-      return output;
-    }
-  }
-  tasks.yield();
+  return Cached(axis_id, CMD_ID_ODRIVE_HEARTBEAT_MESSAGE)[4];
 }
 
 // Some Documentation indicates this returns both voltage and current but only using voltage here
 // which is in first 4 bytes. May be the difference between version 3 and newer versions of ODrive
 float ODriveTeensyCAN::GetVbusVoltage(int axis_id) {  //message can be sent to either axis
-  //byte msg_data[4] = {0, 0, 0, 0};
-  byte msg_data[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-
-  //sendMessage(axis_id, CMD_ID_GET_VBUS_VOLTAGE_CURRENT, true, 4, msg_data);
-  sendMessage(axis_id, CMD_ID_GET_VBUS_VOLTAGE_CURRENT, true, 8, msg_data);
-    float_t output;
-    *((uint8_t *)(&output) + 0) = msg_data[0];
-    *((uint8_t *)(&output) + 1) = msg_data[1];
-    *((uint8_t *)(&output) + 2) = msg_data[2];
-    *((uint8_t *)(&output) + 3) = msg_data[3];
-    *((uint8_t *)(&output) + 4) = msg_data[4];
-    *((uint8_t *)(&output) + 5) = msg_data[5];
-    *((uint8_t *)(&output) + 6) = msg_data[6];
-    *((uint8_t *)(&output) + 7) = msg_data[7];
-    return output;
+  return floatAt(Cached(axis_id, CMD_ID_GET_VBUS_VOLTAGE_CURRENT), 0);
 }
 
+// The reply to this request comes later, so this returns the previous reading
 float ODriveTeensyCAN::GetADCVoltage(int axis_id, uint8_t gpio_num) {
   byte msg_data[4] = {0, 0, 0, 0};
-
 	msg_data[0] = gpio_num;
 	
   sendMessage(axis_id, CMD_ID_GET_ADC_VOLTAGE, false, 1, msg_data);  //RTR must be false!
 
-  float_t output;
-  *((uint8_t *)(&output) + 0) = msg_data[0];
-  *((uint8_t *)(&output) + 1) = msg_data[1];
-  *((uint8_t *)(&output) + 2) = msg_data[2];
-  *((uint8_t *)(&output) + 3) = msg_data[3];
-  return output;
+  if (axis_id < 0 || axis_id >= ODRIVE_CAN_NODES) return 0.0F;
+  return floatAt(cache[axis_id][CMD_ID_GET_ADC_VOLTAGE].buf, 0);
 }
 
 //////////// Other functions ///////////
@@ -3,6 +3,12 @@
 
 #include "Arduino.h"
 
+#define ODRIVE_CAN_NODES      2   // node IDs 0 and 1, one per ODrive axis
+#define ODRIVE_CAN_MAX_AGE   50   // msec, an older cached value is requested again
+#define ODRIVE_CAN_RTR_WAIT  10   // msec, an unanswered request is sent again after this
+#define ODRIVE_CAN_BCAST_RX   3   // unrequested arrivals at a steady period before a value counts as broadcast
+#define ODRIVE_CAN_BCAST_LOST 3   // periods without one before it no longer does
+
 class ODriveTeensyCAN {
   public:
     
@@ -64,9 +70,15 @@ class ODriveTeensyCAN {
     int CANBaudRate = 250000;  //250,000 is odrive default
 
     bool sendMessage(int axis_id, int cmd_id, bool remote_transmission_request, int length, byte *signal_bytes);
-    
-    // Heartbeat
-    int Heartbeat();
+
+    // Hand the frames queued by the receive interrupt to the telemetry cache, run from a task
+    static void events();
+
+    // msec since cmd_id last arrived from axis_id, 0xFFFFFFFF if it never did
+    uint32_t Age(int axis_id, int cmd_id);
+
+    // The ODrive sends cmd_id of axis_id cyclically, so reading it costs no bus traffic
+    bool IsBroadcast(int axis_id, int cmd_id);
 
     // Setters
     void SetAxisNodeId(int axis_id, int node_id);
@@ -98,6 +110,8 @@ class ODriveTeensyCAN {
     uint32_t GetMotorError(int axis_id);
     uint32_t GetEncoderError(int axis_id);
     uint32_t GetAxisError(int axis_id);
+    uint8_t GetMotorFlags(int axis_id);
+    uint8_t GetEncoderFlags(int axis_id);
     uint8_t GetControllerFlags(int axis_id);
     uint8_t GetCurrentState(int axis_id);
     float GetVbusVoltage(int axis_id);  //Can be sent to either axis
@@ -112,6 +126,9 @@ class ODriveTeensyCAN {
     // State helper
     bool RunState(int axis_id, int requested_state);
 
+  private:
+    const uint8_t* Cached(int axis_id, int cmd_id);
+
 };
 
 #endif
\ No newline at end of file
@@ -19,6 +19,9 @@
 // DDScope specific
 #include "Display.h"
 #include "WifiDisplay.h"
+#include "GlyphCache.h"
+#include "SpriteCache.h"
+#include "PalettePlane.h"
 #include "../catalog/Catalog.h"
 #include "../screens/AlignScreen.h"
 #include "../screens/TreasureCatScreen.h"
@@ -110,10 +113,24 @@ L_CE_SLEW_ERR_HARDWARE_FAULT, L_CE_MOUNT_IN_MOTION, L_CE_SLEW_ERR_UNSPECIFIED, L
 #define L_GE_OTHER "Unknown Error, code"
 
 // Menu button object
-Button menuButton(MENU_X, MENU_Y, MENU_BOXSIZE_X, MENU_BOXSIZE_Y, butOnBackground, butBackground, butOutline, largeFontWidth, largeFontHeight, "");
+Button menuButton(MENU_X, MENU_Y, MENU_BOXSIZE_X, MENU_BOXSIZE_Y, &butOnBackground, &butBackground, &butOutline, largeFontWidth, largeFontHeight, "");
 
 // Canvas Print object Custom Font
 CanvasPrint canvDisplayInsPrint(&Inconsolata_Bold8pt7b);
+
+// Retained fields of the common status area, error bars and battery voltage
+// These are refreshed every second (command error on every command) but only repainted on change
+ValueWidget comRaField     (&canvDisplayInsPrint, COM_COL1_DATA_X, COM_COL1_DATA_Y,                       C_WIDTH,    C_HEIGHT);
+ValueWidget comRaTgtField  (&canvDisplayInsPrint, COM_COL1_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE,     C_WIDTH,    C_HEIGHT);
+ValueWidget comDecField    (&canvDisplayInsPrint, COM_COL1_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE*2,   C_WIDTH,    C_HEIGHT);
+ValueWidget comDecTgtField (&canvDisplayInsPrint, COM_COL1_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE*3,   C_WIDTH,    C_HEIGHT);
+ValueWidget comAzmField    (&canvDisplayInsPrint, COM_COL2_DATA_X, COM_COL1_DATA_Y,                       C_WIDTH-20, C_HEIGHT);
+ValueWidget comAzmTgtField (&canvDisplayInsPrint, COM_COL2_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE,     C_WIDTH-20, C_HEIGHT);
+ValueWidget comAltField    (&canvDisplayInsPrint, COM_COL2_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE*2,   C_WIDTH-20, C_HEIGHT);
+ValueWidget comAltTgtField (&canvDisplayInsPrint, COM_COL2_DATA_X, COM_COL1_DATA_Y+COM_LABEL_Y_SPACE*3,   C_WIDTH-20, C_HEIGHT);
+ValueWidget cmdErrField    (&canvDisplayInsPrint, 3, 453, 314, C_HEIGHT+2, false);
+ValueWidget genErrField    (&canvDisplayInsPrint, 3, 470, 314, C_HEIGHT+2, false);
+LabelWidget batVoltField   (&Inconsolata_Bold8pt7b, 135, 29, 50, 14, 135, 40);
                 
 ScreenEnum Display::currentScreen = HOME_SCREEN;
 bool Display::_nightMode = false;
@@ -132,6 +149,25 @@ uint16_t butOnBackground = MAROON;
 uint16_t textColor = DIM_YELLOW; 
 uint16_t butOutline = ORANGE; 
 
+// Theme role colors, in ThemeRole order; tags 0, 4 and 6 are what the plain colors in use carry.
+// The tags keep the red LSB of every color, so only a green or blue LSB changes, one
+// step of 63 or 31 that doesn't show on the panel and is what the palette plane keys on:
+// value on the panel and what it was before the tags
+static const uint16_t dayTheme[THEME_ROLES] = {
+  THEME_TAG(XDARK_MAROON, 5), // page background       0x1801, was 0x1800 (blue +1)
+  THEME_TAG(BLACK,        2), // button background     0x0020, was 0x0000 (green +1)
+  THEME_TAG(MAROON,       7), // button on background  0x7821, was 0x7800 (green +1, blue +1)
+  THEME_TAG(DIM_YELLOW,   7), // text                  0xFE61, was 0xFE60 (blue +1)
+  THEME_TAG(ORANGE,       7), // button outline        0xFD21, was 0xFD20 (blue +1)
+};
+static const uint16_t nightTheme[THEME_ROLES] = {
+  THEME_TAG(BLACK,        1), //                       0x0001, was 0x0000 (blue +1)
+  THEME_TAG(DARK_MAROON,  2), //                       0x3020, was 0x3000 (green +1)
+  THEME_TAG(MAROON,       7), //                       0x7821, was 0x7800 (green +1, blue +1)
+  THEME_TAG(ORANGE,       5), //                       0xFD01, was 0xFD20 (green -1, blue +1)
+  THEME_TAG(ORANGE,       7), //                       0xFD21, was 0xFD20 (blue +1)
+};
+
 // Local cmd channel object
 CommandProcessor processor(9600, 'L');
 
@@ -252,6 +288,7 @@ void Display::refreshButtons() {
 // screen selection
 void Display::setCurrentScreen(ScreenEnum curScreen) {
 currentScreen = curScreen;
+ValueWidget::invalidateAll(); // screen is about to be redrawn from scratch
 };
 
 // select which screen to update at the Update task rate 
@@ -372,7 +409,7 @@ void Display::commandWithReply(const char *command, char *reply) {
   }
   if (currentScreen != XSTATUS_SCREEN) {
     snprintf(cmdErrGlobal, sizeof(cmdErrGlobal), "Cmd Error: %.88s", cmdErrStr[latchedCmdErr]);
-    canvDisplayInsPrint.printLJ(3, 453, 314, C_HEIGHT + 2, cmdErrGlobal, false);
+    cmdErrField.set(cmdErrGlobal, false);
   }
 
   // handle numeric Replies
@@ -393,29 +430,46 @@ void Display::drawTitle(int text_x, int text_y, const char* label) {
   tft.setTextColor(textColor);
   tft.fillRect(TITLE_BOX_X, TITLE_BOX_Y, TITLE_BOXSIZE_X, TITLE_BOXSIZE_Y, titleBackground);
   //tft.drawRect(TITLE_BOX_X, TITLE_BOX_Y, TITLE_BOXSIZE_X, TITLE_BOXSIZE_Y, butOutline);
-  tft.setCursor(TITLE_BOX_X + text_x, TITLE_BOX_Y + text_y);
-  tft.print(label);
+  if (!glyphCache.drawText(TITLE_BOX_X + text_x, TITLE_BOX_Y + text_y, label, &FreeSansBold12pt7b, textColor, titleBackground)) {
+    tft.setCursor(TITLE_BOX_X + text_x, TITLE_BOX_Y + text_y);
+    tft.print(label);
+  }
   tft.setFont(&Inconsolata_Bold8pt7b);
 }
 
 // Color Themes (Day or Night)
 void Display::setNightMode(bool nightMode) {
   _nightMode = nightMode;
-  if (!nightMode) {
-    // Day Color Theme
-    pgBackground = XDARK_MAROON; 
-    butBackground = BLACK;
-    butOnBackground = MAROON;
-    textColor = DIM_YELLOW; 
-    butOutline = ORANGE; 
-  } else {  
-    // Night Color Theme
-    pgBackground = BLACK; 
-    butBackground = DARK_MAROON;
-    butOnBackground = MAROON;
-    textColor = ORANGE; 
-    butOutline = ORANGE; 
-  }
+  const uint16_t* theme = nightMode ? nightTheme : dayTheme;
+  pgBackground    = theme[ROLE_PG_BACKGROUND];
+  butBackground   = theme[ROLE_BUT_BACKGROUND];
+  butOnBackground = theme[ROLE_BUT_ON_BACKGROUND];
+  textColor       = theme[ROLE_TEXT];
+  butOutline      = theme[ROLE_BUT_OUTLINE];
+  #ifdef ENABLE_TFT_PALETTE
+  palettePlane.setRoles(theme);
+  #endif
+  glyphCache.invalidate(); // atlases were expanded for the old colors
+  spriteCache.invalidate(); // and so were the button images
+}
+
+// Show the current theme on the screen without redrawing it, by flushing the
+// palette plane. Returns false if the screen has to be redrawn instead.
+bool Display::recolorScreen() {
+  #ifdef ENABLE_TFT_PALETTE
+    if (!palettePlane.isValid()) return false;
+    #ifdef ENABLE_TFT_MIRROR
+    wifiDisplay.enableScreenCapture(true);
+    #endif
+    bool recolored = palettePlane.flush();
+    #ifdef ENABLE_TFT_MIRROR
+    wifiDisplay.enableScreenCapture(false);
+    if (recolored) wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+    #endif
+    return recolored;
+  #else
+    return false;
+  #endif
 }
 
 bool Display::getNightMode() {
@@ -429,14 +483,7 @@ void Display::updateBatVoltage(int axis) {
     char bvolts[12]="00.0 v";
     sprintf(bvolts, "%4.1f v", currentBatVoltage);
     //if (previousBatVoltage == currentBatVoltage) return;
-    if (currentBatVoltage < BATTERY_LOW_VOLTAGE) { 
-      tft.fillRect(135, 29, 50, 14, butOnBackground);
-    } else {
-      tft.fillRect(135, 29, 50, 14, butBackground);
-    }
-    tft.setFont(&Inconsolata_Bold8pt7b);
-    tft.setCursor(135, 40);
-    tft.print(bvolts);
+    batVoltField.set(bvolts, (currentBatVoltage < BATTERY_LOW_VOLTAGE) ? butOnBackground : butBackground);
   previousBatVoltage = currentBatVoltage;
 }
 
@@ -553,7 +600,7 @@ void Display::showOnStepCmdErr() {
 
   commandWithReply(":GE#", cmdErr);
   strcat(temp, cmdErrStr[atoi(cmdErr)]);
-  canvDisplayInsPrint.printLJ(3, 453, 314, C_HEIGHT+2, temp, false);
+  cmdErrField.set(temp, false);
 }
 
 // ========== OnStep General Errors =============
@@ -572,7 +619,7 @@ void Display::showOnStepGenErr() {
   //error = (genErr[strlen(genErr) - 1] - '0');
   getGeneralErrorMessage(temp, limits.errorCode());
   strcat(temp1, temp);
-  canvDisplayInsPrint.printLJ(3, 470, 314, C_HEIGHT+2, temp1, false);
+  genErrField.set(temp1, false);
 }
 
 // Draw the Menu buttons
@@ -874,8 +921,10 @@ void Display::updateCommonStatus() {
     } else {
       digitalWrite(STATUS_TRACK_LED_PIN, LOW); // LED ON
       tft.setFont(&Inconsolata_Bold8pt7b);
-      tft.setCursor(50, 38);
-      tft.print("Tracking");
+      if (!glyphCache.drawText(50, 38, "Tracking", &Inconsolata_Bold8pt7b, textColor, titleBackground)) {
+        tft.setCursor(50, 38);
+        tft.print("Tracking");
+      }
       trackLedOn = true;
     }
   #ifdef ODRIVE_MOTOR_PRESENT
@@ -901,30 +950,25 @@ void Display::updateCommonStatus() {
   char tra_hms[10]  = "";
   char tdec_dms[11] = "";
   
-  int y_offset = 0;
   // ----- Column 1 -----
   // Current RA, Returns: HH:MM.T# or HH:MM:SS# (based on precision setting)
   commandWithReply(":GR#", ra_hms);
-  canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y, C_WIDTH, C_HEIGHT, ra_hms, false);
+  comRaField.set(ra_hms, false);
 
   // Target RA, Returns: HH:MM.T# or HH:MM:SS (based on precision setting)
-  y_offset +=COM_LABEL_Y_SPACE; 
   commandWithReply(":Gr#", tra_hms);
-  canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, tra_hms, false);
+  comRaTgtField.set(tra_hms, false);
 
   // Current DEC
-   y_offset +=COM_LABEL_Y_SPACE; 
   commandWithReply(":GD#", dec_dms);
-  canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, dec_dms, false);
+  comDecField.set(dec_dms, false);
 
   // Target DEC
-  y_offset +=COM_LABEL_Y_SPACE;  
   commandWithReply(":Gd#", tdec_dms); 
-  canvDisplayInsPrint.printRJ(COM_COL1_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH, C_HEIGHT, tdec_dms, false);
+  comDecTgtField.set(tdec_dms, false);
   //VLF("common column 1 check point complete");
-  // ----- Column 2 -----
-  y_offset =0;
 
+  // ----- Column 2 -----
   Coordinate dispTarget = goTo.getGotoTarget();
   transform.rightAscensionToHourAngle(&dispTarget);
   transform.equToHor(&dispTarget);
@@ -932,28 +976,22 @@ void Display::updateCommonStatus() {
   // Get CURRENT AZM
   //commandWithReply(":GZ#", cAzmDMS); // DDD*MM'SS# 
   //convert.dmsToDouble(&cAzm_d, cAzmDMS, false, PM_LOW);
-  double temp = NormalizeAzimuth(radToDeg(mount.getPosition(CR_MOUNT_HOR).z));
-  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
+  comAzmField.set(NormalizeAzimuth(radToDeg(mount.getPosition(CR_MOUNT_HOR).z)), false);
 
   // Get TARGET AZM
-  y_offset +=COM_LABEL_Y_SPACE;  
   //commandWithReply(":Gz#", tAzmDMS); // DDD*MM'SS# 
   //convert.dmsToDouble(&tAzm_d, tAzmDMS, false, PM_LOW);
-  temp = NormalizeAzimuth(radToDeg(dispTarget.z));
-  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
+  comAzmTgtField.set(NormalizeAzimuth(radToDeg(dispTarget.z)), false);
 
   // Get CURRENT ALT
-  y_offset +=COM_LABEL_Y_SPACE;  
   //commandWithReply(":GA#", cAltDMS);	// sDD*MM'SS#
   //convert.dmsToDouble(&cAlt_d, cAltDMS, true, PM_LOW);
-  temp = radToDeg(mount.getPosition(CR_MOUNT_ALT).a);
-  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, temp, false);
+  comAltField.set(radToDeg(mount.getPosition(CR_MOUNT_ALT).a), false);
   
   // Get TARGET ALT
-  y_offset +=COM_LABEL_Y_SPACE;  
   //commandWithReply(":Gal#", tAltDMS);	// sDD*MM'SS#
   //convert.dmsToDouble(&tAlt_d, tAltDMS, true, PM_LOW);
-  canvDisplayInsPrint.printRJ(COM_COL2_DATA_X, COM_COL1_DATA_Y+y_offset, C_WIDTH-20, C_HEIGHT, radToDeg(dispTarget.a), false);
+  comAltTgtField.set(radToDeg(dispTarget.a), false);
   //VLF("column 2 complete");
 }
 
@@ -12,13 +12,48 @@
 //=====================================================================================
 // COMPILE-TIME SWITCH to enable redirect of pixel commands of each Screen to a WiFi client
 #define ENABLE_TFT_MIRROR  // Comment this line to disable screen redirect
-#define FRAME_TYPE_RAW  0x00 // Raw frame of 307600 bytes
-#define FRAME_TYPE_RLE  0x01 // Run Length encoding
-#define FRAME_TYPE_LZ4  0x02 // removed this because native JavaScript support limited
-#define FRAME_TYPE_DIF  0x03 // Differential pixel encoding...removed due to complexity
-#define FRAME_TYPE_DEF  0x04 // Deflate compression is a lossless data compression algorithm 
-                             // that combines the LZ77 algorithm and Huffman coding to 
-                             // reduce the size of data. Has Native browser support.
+#include "FrameTypes.h"   // FRAME_TYPE_* sent ahead of each frame
+
+// COMPILE-TIME SWITCH to send only the changed tiles between periodic full frames,
+// the ESP32-S3 web page has to decode FRAME_TYPE_TIL (see WifiHandController.md)
+#define ENABLE_TFT_TILES  // Comment this line to always send full Deflate frames
+
+// COMPILE-TIME SWITCH to let FRAME_TYPE_DEF keyframes go out as RAW, RLE or Deflate
+// (fast or default level), whichever the mirror measured cheapest for the kind of screen
+#define ENABLE_TFT_ADAPTIVE  // Comment this line to always send Deflate keyframes
+
+// COMPILE-TIME SWITCH to allow FRAME_TYPE_PAL keyframes, the ESP32-S3 web page has to
+// decode them (see WifiHandController.md)
+#define ENABLE_TFT_PAL_FRAMES  // Comment this line to never send palette frames
+
+// COMPILE-TIME SWITCH to send deltas as the recorded GFX draw calls (DrawRecorder.h)
+// when that is smaller than the changed tiles, needs ENABLE_TFT_TILES and a web page
+// that replays FRAME_TYPE_CMD (see WifiHandController.md)
+#define ENABLE_TFT_DRAWCMDS  // Comment this line to send pixel deltas only
+
+// COMPILE-TIME SWITCH to run the mirror against a fake ESP32-S3 inside the Teensy
+// (EspLoopback.h) instead of the USB host serial, reports latency and stalls on SERIAL_DEBUG
+//#define ENABLE_ESP_LOOPBACK  // Uncomment this line to test the mirror without the ESP32-S3
+
+// COMPILE-TIME SWITCH to benchmark the mirror codecs at boot over the tft_*_log.bin
+// screen captures on the SD card (MirrorBench.h), results in /mirror_bench.csv
+//#define ENABLE_MIRROR_BENCHMARK  // Uncomment this line to run the benchmark
+
+// COMPILE-TIME SWITCH to record every mirror frame from boot on to /session_NNN.bin on
+// the SD card, written in the background by the sdWriter task (SdWriter.h)
+//#define ENABLE_TFT_RECORDING  // Uncomment this line to record the UI session
+//=====================================================================================
+
+//=====================================================================================
+// COMPILE-TIME SWITCH to keep a 4-bit palette index copy of the screen so that a
+// Day/Night theme change is a palette swap and one flush instead of a full redraw
+#define ENABLE_TFT_PALETTE  // Comment this line to disable the palette plane
+//=====================================================================================
+
+//=====================================================================================
+// COMPILE-TIME SWITCH to sample the ODrive motors at 100 Hz out of the CAN telemetry
+// cache (MotorTelemetry.h) for the strip chart on the ODrive screen, OD_CAN only
+#define ENABLE_MOTOR_TELEMETRY  // Comment this line to disable the sampler and the plot
 //=====================================================================================
 
 #include <Arduino.h>
@@ -37,6 +72,7 @@
 #include "src/lib/tasks/OnTask.h"
 #include "src/libApp/commands/ProcessCmds.h"
 #include "UIelements.h"
+#include "UILayout.h"
 
 class AlignScreen;
 class Catalog;
@@ -130,6 +166,13 @@ class WifiDisplay;
 #define DARK_MAROON 0x3000      /* 197,   0,   0*/
 #define GRAY_BLACK  0x0840
 
+// Theme colors carry a 3 bit role tag in the least significant bit of R, G and B,
+// one step of a channel at most (see the themes in Display.cpp for the exact
+// values). It keeps every theme role a distinct RGB565
+// value, from the other roles and from the plain colors above, so the palette
+// plane knows which pixels to recolor on a theme change.
+#define THEME_TAG(color, tag) (((color) & ~0x0821) | (((tag) & 4) << 9) | (((tag) & 2) << 4) | ((tag) & 1))
+
 // recommended cutoff for LiPo battery is 19.2V but want some saftey margin
 #define BATTERY_LOW_VOLTAGE   21.0  
 
@@ -229,6 +272,7 @@ class Display {
     // Day or Night Modes
     void setNightMode(bool);
     bool getNightMode();
+    bool recolorScreen();
 
     // frequency and duration adjustable tone
     inline void soundFreq(int freq, int duration) { tone(STATUS_BUZZER_PIN, freq, duration); }
@@ -0,0 +1,242 @@
+// =====================================================
+// DrawRecorder.cpp
+//
+// GFX drawing calls of the TFT as a command stream, see DrawRecorder.h
+
+#include "Display.h"
+#include "DrawRecorder.h"
+
+#ifdef ENABLE_TFT_DRAWCMDS
+
+#include "../fonts/Inconsolata_Bold8pt7b.h"
+#include "../fonts/UbuntuMono_Bold8pt7b.h"
+#include "../fonts/UbuntuMono_Bold11pt7b.h"
+#include <Fonts/FreeSansBold9pt7b.h>
+#include <Fonts/FreeSansBold12pt7b.h>
+
+EXTMEM static uint8_t streamData[2][DRAWCMD_BUFFER_SIZE];
+
+// Font ids of the stream, the web page has the same fonts in the same order.
+// Id 0 is the built-in 5x7 GFX font.
+static const GFXfont* const fonts[] = {
+  NULL,
+  &Inconsolata_Bold8pt7b,
+  &UbuntuMono_Bold8pt7b,
+  &UbuntuMono_Bold11pt7b,
+  &FreeSansBold9pt7b,
+  &FreeSansBold12pt7b
+};
+
+static inline void put16(uint8_t*& p, int16_t v) {
+  *p++ = v & 0xFF;
+  *p++ = (uint16_t)v >> 8;
+}
+
+// Set the bits of the tiles under a window, clipped to the screen
+static void markTiles(uint32_t* bits, int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > SCREEN_WIDTH) w = SCREEN_WIDTH - x;
+  if (y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - y;
+  if (w < 1 || h < 1) return;
+  for (uint16_t ty = y / TILE_SIZE; ty <= (y + h - 1) / TILE_SIZE; ty++) {
+    for (uint16_t tx = x / TILE_SIZE; tx <= (x + w - 1) / TILE_SIZE; tx++) {
+      uint16_t tile = ty * TILE_COLS + tx;
+      bits[tile >> 5] |= 1UL << (tile & 31);
+    }
+  }
+}
+
+DrawRecorder::DrawRecorder() {
+  for (uint8_t i = 0; i < 2; i++) {
+    streams[i].data = streamData[i];
+    streams[i].size = 0;
+    memset(streams[i].tiles, 0, sizeof(streams[i].tiles));
+    memset(streams[i].inexact, 0, sizeof(streams[i].inexact));
+  }
+  streams[0].valid = true;
+  streams[1].valid = false; // nothing finished yet
+  cur = &streams[0];
+  done = &streams[1];
+}
+
+// Room for a command and its arguments, NULL while paused or once the stream
+// no longer stands for the frame
+uint8_t* DrawRecorder::reserve(uint8_t command, uint32_t bytes) {
+  if (paused || !cur->valid) return NULL;
+  if (cur->size + 1 + bytes > DRAWCMD_BUFFER_SIZE) {
+    cur->valid = false;
+    return NULL;
+  }
+  uint8_t* p = cur->data + cur->size;
+  cur->size += 1 + bytes;
+  *p++ = command;
+  return p;
+}
+
+// A solid window, as the driver sends it: pixels, lines and rectangles
+void DrawRecorder::fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (w < 1 || h < 1) return;
+  uint8_t* p;
+  if (w == 1 && h == 1) {
+    if ((p = reserve(DRAW_PIXEL, 6)) == NULL) return;
+  } else if (h == 1) {
+    if ((p = reserve(DRAW_HLINE, 8)) == NULL) return;
+    put16(p, x); put16(p, y); put16(p, w); put16(p, color);
+    return;
+  } else if (w == 1) {
+    if ((p = reserve(DRAW_VLINE, 8)) == NULL) return;
+    put16(p, x); put16(p, y); put16(p, h); put16(p, color);
+    return;
+  } else {
+    if ((p = reserve(DRAW_FILL, 10)) == NULL) return;
+    put16(p, x); put16(p, y); put16(p, w); put16(p, h); put16(p, color);
+    return;
+  }
+  put16(p, x); put16(p, y); put16(p, color);
+}
+
+// An image nobody recorded as calls, its tiles go as pixels
+void DrawRecorder::pixels(int16_t x, int16_t y, int16_t w, int16_t h) {
+  if (paused) return;
+  markTiles(cur->tiles, x, y, w, h);
+}
+
+// Pixel tiles inside the band move with it, so they all go as pixels. So does
+// replayed text, this frame's or the last one's, which is marked where it was.
+void DrawRecorder::scroll(uint16_t top, uint16_t height, int16_t lines) {
+  uint16_t firstRow = top / TILE_SIZE;
+  uint16_t lastRow = (top + height - 1) / TILE_SIZE;
+  for (uint16_t tile = firstRow * TILE_COLS; tile < (lastRow + 1) * TILE_COLS; tile++) {
+    if ((cur->tiles[tile >> 5] | cur->inexact[tile >> 5] | done->inexact[tile >> 5]) & (1UL << (tile & 31))) {
+      pixels(0, top, SCREEN_WIDTH, height);
+      break;
+    }
+  }
+  uint8_t* p = reserve(DRAW_SCROLL, 6);
+  if (p == NULL) return;
+  put16(p, top); put16(p, height); put16(p, lines);
+}
+
+void DrawRecorder::roundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color, bool filled) {
+  uint8_t* p = reserve(filled ? DRAW_FILL_RRECT : DRAW_RRECT, 12);
+  if (p == NULL) return;
+  markTiles(cur->inexact, x, y, w, h);
+  put16(p, x); put16(p, y); put16(p, w); put16(p, h); put16(p, r); put16(p, color);
+}
+
+// Text drawn like GFX print() with wrapping off from the cursor (baseline for
+// GFX fonts) at x, y. bg only counts for the built-in font and when it differs
+// from fg, as in GFX. Characters that continue the last text at endX of that
+// call are added to it.
+void DrawRecorder::text(int16_t x, int16_t y, const GFXfont* f, uint8_t size, uint16_t fg, uint16_t bg,
+                        const char* s, uint16_t len, int16_t endX) {
+  if (paused || !cur->valid || len == 0) return;
+  uint8_t id = fontId(f);
+  if (id == DRAWCMD_FONT_NONE || len > 255) {
+    cur->valid = false;
+    return;
+  }
+
+  // glyphs reach about a line above the baseline and half a line below, and
+  // may stick out of their advance by a few pixels
+  if (f == NULL) markTiles(cur->inexact, x, y, endX - x, 8 * size);
+  else markTiles(cur->inexact, x - 4 * size, y - f->yAdvance * size, endX - x + 8 * size, f->yAdvance * size * 3 / 2);
+
+  if (lastText >= 0 && (uint32_t)lastText < cur->size) {
+    uint8_t* t = cur->data + lastText;
+    uint8_t tlen = t[11];
+    if ((uint32_t)lastText + 12 + tlen == cur->size && x == lastTextEndX &&
+        t[3] == (y & 0xFF) && t[4] == ((uint16_t)y >> 8) && t[5] == id && t[6] == size &&
+        t[7] == (fg & 0xFF) && t[8] == (fg >> 8) && t[9] == (bg & 0xFF) && t[10] == (bg >> 8) &&
+        tlen + len <= 255) {
+      if (cur->size + len > DRAWCMD_BUFFER_SIZE) {
+        cur->valid = false;
+        return;
+      }
+      memcpy(cur->data + cur->size, s, len);
+      cur->size += len;
+      t[11] = tlen + len;
+      lastTextEndX = endX;
+      return;
+    }
+  }
+
+  uint32_t start = cur->size;
+  uint8_t* p = reserve(DRAW_TEXT, 11 + len);
+  if (p == NULL) return;
+  put16(p, x); put16(p, y);
+  *p++ = id;
+  *p++ = size;
+  put16(p, fg); put16(p, bg);
+  *p++ = len;
+  memcpy(p, s, len);
+  lastText = start;
+  lastTextEndX = endX;
+}
+
+void DrawRecorder::clip(int16_t x, int16_t y, int16_t w, int16_t h) {
+  uint8_t* p = reserve(DRAW_CLIP, 8);
+  if (p == NULL) return;
+  put16(p, x); put16(p, y); put16(p, w); put16(p, h);
+}
+
+void DrawRecorder::swap() {
+  Stream* finished = cur;
+  cur = done;
+  done = finished;
+  cur->size = 0;
+  cur->valid = true;
+  memset(cur->tiles, 0, sizeof(cur->tiles));
+  memset(cur->inexact, 0, sizeof(cur->inexact));
+  lastText = -1;
+}
+
+uint16_t DrawRecorder::pixelTiles(uint16_t* list, const uint32_t* also) {
+  uint16_t count = 0;
+  for (uint16_t word = 0; word < (TILE_COUNT + 31) / 32; word++) {
+    uint32_t bits = done->tiles[word] | also[word];
+    while (bits) {
+      list[count++] = word * 32 + __builtin_ctz(bits);
+      bits &= bits - 1;
+    }
+  }
+  return count;
+}
+
+void DrawRecorder::inexactTiles(uint32_t* bits) {
+  for (uint16_t word = 0; word < (TILE_COUNT + 31) / 32; word++) bits[word] = done->inexact[word] & ~done->tiles[word];
+}
+
+// Every source file has its own copy of a font, so a font is known by its
+// glyph table rather than its address; the addresses seen are cached
+uint8_t DrawRecorder::fontId(const GFXfont* f) {
+  if (f == NULL) return 0;
+  for (uint8_t i = 0; i < cachedCount; i++)
+    if (cachedFont[i] == f) return cachedId[i];
+
+  uint8_t id = DRAWCMD_FONT_NONE;
+  for (uint8_t i = 1; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+    const GFXfont* k = fonts[i];
+    if (f->first != k->first || f->last != k->last || f->yAdvance != k->yAdvance) continue;
+    if (memcmp(f->glyph, k->glyph, (k->last - k->first + 1) * sizeof(GFXglyph)) == 0) { id = i; break; }
+  }
+  if (id == DRAWCMD_FONT_NONE) VLF("MSG: DrawRecorder, font not in the mirror font table");
+  if (cachedCount < DRAWCMD_FONT_CACHE) {
+    cachedFont[cachedCount] = f;
+    cachedId[cachedCount++] = id;
+  }
+  return id;
+}
+
+const GFXfont* DrawRecorder::font(uint8_t id) {
+  return (id < fontCount()) ? fonts[id] : NULL;
+}
+
+uint8_t DrawRecorder::fontCount() {
+  return sizeof(fonts) / sizeof(fonts[0]);
+}
+
+DrawRecorder drawRecorder;
+
+#endif
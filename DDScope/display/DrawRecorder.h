@@ -0,0 +1,104 @@
+// =====================================================
+// DrawRecorder.h
+// GFX drawing calls of the TFT as a command stream for the WiFi mirror
+//
+// A screen is a few hundred fills, lines, rounded rectangles and strings, so
+// between two mirror frames the recorder keeps the calls themselves instead of
+// their pixels. The driver reports every solid fill window, hardware scroll and
+// character it draws; the button sprites, glyph cache and CanvasPrint fields
+// report the rounded rectangles and text their blits stand for. The web page
+// replays the stream with the same GFX rules on top of the frame it shows.
+// Anything that is only known as pixels (bitmaps, icons, palette flushes) marks
+// its 16x16 tiles, which go along as RGB565 tiles from the finished frame.
+// Fills, lines and scrolls replay pixel for pixel. Text and rounded rectangles
+// depend on the page's GFX port getting every glyph and corner right, so their
+// tiles are marked as well and WifiDisplay sends them as pixels in the next
+// delta (see takeFrame()).
+
+#ifndef DRAW_RECORDER_H
+#define DRAW_RECORDER_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+#include "WifiDisplay.h"
+
+#define DRAWCMD_BUFFER_SIZE  8192  // per frame, a full screen redraw is 3-5KB
+#define DRAWCMD_FONT_CACHE      8  // font pointers already matched to an id
+#define DRAWCMD_FONT_NONE    0xFF
+
+// Commands, all numbers little-endian 16-bit, colors RGB565 (see WifiHandController.md)
+typedef enum {
+  DRAW_FILL       = 0x01, // x, y, w, h, color
+  DRAW_HLINE      = 0x02, // x, y, w, color
+  DRAW_VLINE      = 0x03, // x, y, h, color
+  DRAW_PIXEL      = 0x04, // x, y, color
+  DRAW_FILL_RRECT = 0x05, // x, y, w, h, r, color
+  DRAW_RRECT      = 0x06, // x, y, w, h, r, color
+  DRAW_TEXT       = 0x07, // x, y, font u8, size u8, fg, bg, len u8, chars
+  DRAW_CLIP       = 0x08, // x, y, w, h, w 0 for the whole screen
+  DRAW_SCROLL     = 0x09  // top, height, lines (> 0 moves up)
+} DrawCommand;
+
+class DrawRecorder {
+  public:
+    DrawRecorder();
+
+    // Driver hooks
+    void fill(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void pixels(int16_t x, int16_t y, int16_t w, int16_t h);
+    void scroll(uint16_t top, uint16_t height, int16_t lines);
+
+    // Calls that are drawn as a blit, recorded after the blit went out
+    void roundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color, bool filled);
+    void text(int16_t x, int16_t y, const GFXfont* font, uint8_t size, uint16_t fg, uint16_t bg,
+              const char* s, uint16_t len, int16_t endX);
+    void clip(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    // Drawing in between is part of a call that is recorded as a whole
+    void pause() { paused++; }
+    void resume() { if (paused) paused--; }
+
+    // Frame boundary: the stream recorded so far becomes the finished one
+    // and a new one starts
+    void swap();
+
+    // Finished stream, false if it can't stand for the frame (buffer full, unknown font)
+    bool isValid() { return done->valid; }
+    const uint8_t* data() { return done->data; }
+    uint32_t size() { return done->size; }
+    // Tiles drawn as pixels, and those set in also, into list, returns how many
+    uint16_t pixelTiles(uint16_t* list, const uint32_t* also);
+    // Tiles with text or rounded rectangles that aren't sent as pixels
+    void inexactTiles(uint32_t* bits);
+
+    // Font of an id in the stream, NULL for the built-in GFX font
+    static const GFXfont* font(uint8_t id);
+    static uint8_t fontCount();
+
+  private:
+    struct Stream {
+      uint8_t* data;
+      uint32_t size;
+      bool     valid;
+      uint32_t tiles[(TILE_COUNT + 31) / 32]; // drawn as pixels
+      uint32_t inexact[(TILE_COUNT + 31) / 32]; // text and rounded rectangles
+    };
+
+    uint8_t* reserve(uint8_t command, uint32_t bytes);
+    uint8_t  fontId(const GFXfont* f);
+
+    Stream   streams[2];
+    Stream*  cur;             // being recorded
+    Stream*  done;            // up to the last swap()
+    uint8_t  paused = 0;
+    int32_t  lastText = -1;   // offset of the TEXT command more characters can join
+    int16_t  lastTextEndX = 0;
+
+    const GFXfont* cachedFont[DRAWCMD_FONT_CACHE];
+    uint8_t  cachedId[DRAWCMD_FONT_CACHE];
+    uint8_t  cachedCount = 0;
+};
+
+extern DrawRecorder drawRecorder;
+
+#endif
@@ -0,0 +1,444 @@
+// =====================================================
+// EspLoopback.cpp
+//
+// Fake ESP32-S3 peer for the WiFi mirror link, see EspLoopback.h
+
+#include "Display.h"
+#include "EspLoopback.h"
+#include "DrawRecorder.h"
+#include "miniz.h"
+
+#ifdef ENABLE_ESP_LOOPBACK
+
+// what the web page would show, and the message being received
+EXTMEM static uint8_t peerFrame[UNCOMPRESSED_BUFFER_SIZE];
+EXTMEM static uint8_t payload[COMPRESSED_BUFFER_SIZE + 1];
+#ifdef ENABLE_TFT_DRAWCMDS
+EXTMEM static uint8_t tileScratch[4 + DRAWCMD_BUFFER_SIZE + 2 + TILE_COUNT * (2 + TILE_SIZE * TILE_SIZE * COLOR_DEPTH)];
+#else
+EXTMEM static uint8_t tileScratch[2 + TILE_COUNT * (2 + TILE_SIZE * TILE_SIZE * COLOR_DEPTH)];
+#endif
+
+const uint8_t *EspLoopback::screen() {
+  return peerFrame;
+}
+
+// ======== Stream side, called by WifiDisplay ========
+int EspLoopback::available() {
+  service();
+  return rxCount;
+}
+
+int EspLoopback::read() {
+  service();
+  if (rxCount == 0) return -1;
+  uint8_t c = rxFifo[rxHead];
+  rxHead = (rxHead + 1) % LOOPBACK_RX_FIFO;
+  rxCount--;
+  return c;
+}
+
+int EspLoopback::peek() {
+  service();
+  return rxCount ? rxFifo[rxHead] : -1;
+}
+
+size_t EspLoopback::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+// Only what fits in the FIFO is taken, like a full USB buffer
+size_t EspLoopback::write(const uint8_t *buffer, size_t size) {
+  service();
+  size_t n = 0;
+  while (n < size && txCount < LOOPBACK_TX_FIFO) {
+    txFifo[(txHead + txCount) % LOOPBACK_TX_FIFO] = buffer[n++];
+    txCount++;
+  }
+  return n;
+}
+
+int EspLoopback::availableForWrite() {
+  service();
+  return LOOPBACK_TX_FIFO - txCount;
+}
+
+// ======== Peer side ========
+// Hand the peer as many bytes as the link rate allows since the last call,
+// then run the touch script and the stall checks
+void EspLoopback::service() {
+  uint32_t nowUs = micros();
+  drainCredit += (nowUs - lastDrainUs) * (LOOPBACK_BYTES_PER_MS / 1000.0f);
+  lastDrainUs = nowUs;
+  while (txCount && drainCredit >= 1.0f) {
+    uint8_t c = txFifo[txHead];
+    txHead = (txHead + 1) % LOOPBACK_TX_FIFO;
+    txCount--;
+    drainCredit -= 1.0f;
+    receive(c);
+  }
+  if (txCount == 0 && drainCredit > 64.0f) drainCredit = 64.0f; // an idle link doesn't save up
+
+  unsigned long ms = millis();
+
+  // touch the menu bar buttons in turn, every one of them changes the screen
+  if (LOOPBACK_TOUCH_MS && connected && ms - lastTouchMs > LOOPBACK_TOUCH_MS) {
+    uint16_t x = MENU_X + (touchStep % 4) * MENU_X_SPACING + MENU_BOXSIZE_X / 2;
+    uint16_t y = MENU_Y + MENU_BOXSIZE_Y / 2;
+    uint8_t touch[4] = { (uint8_t)(x & 0xFF), (uint8_t)(x >> 8), (uint8_t)(y & 0xFF), (uint8_t)(y >> 8) };
+    send(MSG_TOUCH, touch, sizeof(touch));
+    if (touchSentMs == 0) touchSentMs = ms;
+    lastTouchMs = ms;
+    touchStep++;
+  }
+
+  if (msgPos && ms - msgStartMs > LOOPBACK_STALL_MS) {
+    SERIAL_DEBUG.println("Loopback: message stalled half way");
+    stalls++;
+    msgPos = 0;
+  }
+  if (touchSentMs && ms - touchSentMs > LOOPBACK_STALL_MS) {
+    SERIAL_DEBUG.println("Loopback: no frame after touch");
+    stalls++;
+    touchSentMs = 0;
+  }
+  if (ms - lastReportMs > LOOPBACK_REPORT_MS) report();
+}
+
+// Collect one message the way the ESP32-S3 does: sync, header, payload, CRC
+void EspLoopback::receive(uint8_t c) {
+  if (msgPos == 0) {
+    if (c != LINK_SYNC0) return;
+    msgStartMs = millis();
+    frameStartUs = micros();
+  } else if (msgPos == 1 && c != LINK_SYNC1) {
+    msgPos = (c == LINK_SYNC0) ? 1 : 0;
+    return;
+  }
+
+  if (msgPos < LINK_HEADER_SIZE) {
+    header[msgPos++] = c;
+    if (msgPos == LINK_HEADER_SIZE) {
+      msgLen = header[5] | (header[6] << 8) | ((uint32_t)header[7] << 16) | ((uint32_t)header[8] << 24);
+      if (msgLen > sizeof(payload)) {
+        SERIAL_DEBUG.println("Loopback: message too long");
+        errors++;
+        msgPos = 0;
+      }
+    }
+    return;
+  }
+
+  uint32_t pos = msgPos - LINK_HEADER_SIZE;
+  msgPos++;
+  if (pos < msgLen) {
+    // a bad byte now and then, the Teensy has to get over it with one keyframe
+    if (pos == msgLen / 2 && header[2] >= MSG_KEYFRAME &&
+        (corruptNext || (LOOPBACK_CORRUPT_EVERY && ++framesSeen % LOOPBACK_CORRUPT_EVERY == 0))) {
+      c ^= 0x01;
+      corruptNext = false;
+    }
+    payload[pos] = c;
+    return;
+  }
+  crcBytes[pos - msgLen] = c;
+  if (pos - msgLen == LINK_CRC_SIZE - 1) {
+    msgPos = 0;
+    handleMessage();
+  }
+}
+
+void EspLoopback::handleMessage() {
+  uint8_t type = header[2];
+  uint16_t seq = header[3] | (header[4] << 8);
+  uint32_t crc = crcBytes[0] | (crcBytes[1] << 8) | ((uint32_t)crcBytes[2] << 16) | ((uint32_t)crcBytes[3] << 24);
+  uint32_t check = mz_crc32(MZ_CRC32_INIT, header + 2, LINK_HEADER_SIZE - 2);
+  check = mz_crc32(check, payload, msgLen);
+  if (check != crc) {
+    SERIAL_DEBUG.println("Loopback: CRC error");
+    errors++;
+    if (connected && !needKeyframe) {
+      needKeyframe = true;
+      resyncs++;
+      send(MSG_RESYNC, nullptr, 0);
+    }
+    return;
+  }
+  bool gap = seqValid && seq != (uint16_t)(lastSeq + 1);
+  lastSeq = seq;
+  seqValid = true;
+
+  switch (type) {
+  case MSG_HELLO:
+    connected = false;
+    send(MSG_HELLO_ACK, nullptr, 0);
+  break;
+
+  case MSG_IP_REQUEST:
+    send(MSG_IP, (const uint8_t *)"loopback", 8);
+  break;
+
+  case MSG_ACK:
+    // the Teensy ACKs the IP, then the "web client" connects
+    if (!connected) {
+      connected = true;
+      needKeyframe = true;
+      send(MSG_CLIENT, nullptr, 0);
+    }
+  break;
+
+  case MSG_KEYFRAME:
+  case MSG_DELTA: {
+    bytes += LINK_HEADER_SIZE + msgLen + LINK_CRC_SIZE;
+    bool ok = msgLen >= 1;
+    if (ok && type == MSG_DELTA && (needKeyframe || gap)) {
+      // a delta on top of a frame this side doesn't have
+      if (!needKeyframe) {
+        needKeyframe = true;
+        resyncs++;
+        send(MSG_RESYNC, nullptr, 0);
+      }
+    } else if (ok && decodeFrame(payload[0], payload + 1, msgLen - 1)) {
+      if (type == MSG_KEYFRAME) { keyframes++; needKeyframe = false; } else deltas++;
+      uint32_t us = micros() - frameStartUs;
+      latencySumUs += us;
+      if (us > latencyMaxUs) latencyMaxUs = us;
+      if (touchSentMs) {
+        uint32_t touchMs = millis() - touchSentMs;
+        touchSumMs += touchMs;
+        if (touchMs > touchMaxMs) touchMaxMs = touchMs;
+        touches++;
+        touchSentMs = 0;
+      }
+    } else {
+      SERIAL_DEBUG.printf("Loopback: can't decode codec 0x%02X\n", msgLen ? payload[0] : 0);
+      errors++;
+      needKeyframe = true;
+      resyncs++;
+      send(MSG_RESYNC, nullptr, 0);
+    }
+    // every frame with a good CRC is ACKed, applied or not
+    uint8_t ack[2] = { (uint8_t)(seq & 0xFF), (uint8_t)(seq >> 8) };
+    send(MSG_ACK, ack, sizeof(ack));
+  } break;
+
+  default:
+    SERIAL_DEBUG.printf("Loopback: unexpected message 0x%02X\n", type);
+    errors++;
+  break;
+  }
+}
+
+// Copy [tile count u16] then per tile [tile index u16][16x16 RGB565] into the
+// screen, n is the number of bytes at src
+static bool applyTiles(const uint8_t *src, size_t n) {
+  if (n < 2) return false;
+  uint16_t count = src[0] | (src[1] << 8);
+  const size_t tileBytes = TILE_SIZE * TILE_SIZE * COLOR_DEPTH;
+  if (n != 2 + count * (2 + tileBytes)) return false;
+  src += 2;
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t tile = src[0] | (src[1] << 8);
+    if (tile >= TILE_COUNT) return false;
+    src += 2;
+    uint8_t *row = peerFrame + ((tile / TILE_COLS) * TILE_SIZE * SCREEN_WIDTH + (tile % TILE_COLS) * TILE_SIZE) * COLOR_DEPTH;
+    for (uint8_t y = 0; y < TILE_SIZE; y++) {
+      memcpy(row, src, TILE_SIZE * COLOR_DEPTH);
+      row += SCREEN_WIDTH * COLOR_DEPTH;
+      src += TILE_SIZE * COLOR_DEPTH;
+    }
+  }
+  return true;
+}
+
+#ifdef ENABLE_TFT_DRAWCMDS
+// GFX target over the peer's copy of the screen, big-endian pixels like a
+// frame, for replaying draw commands the way the web page does
+class PeerCanvas : public Adafruit_GFX {
+  public:
+    PeerCanvas() : Adafruit_GFX(SCREEN_WIDTH, SCREEN_HEIGHT) {}
+    void setClip(int16_t x, int16_t y, int16_t w, int16_t h) {
+      if (w <= 0) { x = 0; y = 0; w = SCREEN_WIDTH; h = SCREEN_HEIGHT; }
+      clipX0 = max(x, (int16_t)0);
+      clipY0 = max(y, (int16_t)0);
+      clipX1 = min((int16_t)(x + w), (int16_t)SCREEN_WIDTH);
+      clipY1 = min((int16_t)(y + h), (int16_t)SCREEN_HEIGHT);
+    }
+    void drawPixel(int16_t x, int16_t y, uint16_t color) { fillRect(x, y, 1, 1, color); }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+      int16_t x0 = max(x, clipX0), y0 = max(y, clipY0);
+      int16_t x1 = min((int16_t)(x + w), clipX1), y1 = min((int16_t)(y + h), clipY1);
+      for (int16_t row = y0; row < y1; row++) {
+        uint8_t *p = peerFrame + (row * SCREEN_WIDTH + x0) * COLOR_DEPTH;
+        for (int16_t col = x0; col < x1; col++) { *p++ = color >> 8; *p++ = color & 0xFF; }
+      }
+    }
+    // same as the driver's hardware scroll of a band of rows
+    void scroll(uint16_t top, uint16_t height, int16_t lines) {
+      uint32_t n = abs(lines);
+      if (n == 0 || n >= height || top + height > SCREEN_HEIGHT) return;
+      uint8_t *band = peerFrame + top * SCREEN_WIDTH * COLOR_DEPTH;
+      uint32_t rowBytes = SCREEN_WIDTH * COLOR_DEPTH;
+      if (lines > 0) memmove(band, band + n * rowBytes, (height - n) * rowBytes);
+      else           memmove(band + n * rowBytes, band, (height - n) * rowBytes);
+    }
+
+  private:
+    int16_t clipX0 = 0, clipY0 = 0, clipX1 = SCREEN_WIDTH, clipY1 = SCREEN_HEIGHT;
+};
+static PeerCanvas peerCanvas;
+
+static inline int16_t get16(const uint8_t *p) { return (int16_t)(p[0] | (p[1] << 8)); }
+
+// Replay n bytes of draw commands on the peer's screen
+static bool replayCommands(const uint8_t *p, uint32_t n) {
+  static const uint8_t argBytes[] = { 0, 10, 8, 8, 6, 12, 12, 11, 8, 6 }; // by DrawCommand
+  const uint8_t *end = p + n;
+  bool ok = true;
+  peerCanvas.setClip(0, 0, 0, 0);
+  while (ok && p < end) {
+    uint8_t cmd = *p++;
+    if (cmd == 0 || cmd >= sizeof(argBytes) || p + argBytes[cmd] > end) { ok = false; break; }
+    const uint8_t *a = p;
+    p += argBytes[cmd];
+    switch (cmd) {
+    case DRAW_FILL:       peerCanvas.fillRect(get16(a), get16(a + 2), get16(a + 4), get16(a + 6), get16(a + 8)); break;
+    case DRAW_HLINE:      peerCanvas.drawFastHLine(get16(a), get16(a + 2), get16(a + 4), get16(a + 6)); break;
+    case DRAW_VLINE:      peerCanvas.drawFastVLine(get16(a), get16(a + 2), get16(a + 4), get16(a + 6)); break;
+    case DRAW_PIXEL:      peerCanvas.drawPixel(get16(a), get16(a + 2), get16(a + 4)); break;
+    case DRAW_FILL_RRECT: peerCanvas.fillRoundRect(get16(a), get16(a + 2), get16(a + 4), get16(a + 6), get16(a + 8), get16(a + 10)); break;
+    case DRAW_RRECT:      peerCanvas.drawRoundRect(get16(a), get16(a + 2), get16(a + 4), get16(a + 6), get16(a + 8), get16(a + 10)); break;
+    case DRAW_CLIP:       peerCanvas.setClip(get16(a), get16(a + 2), get16(a + 4), get16(a + 6)); break;
+    case DRAW_SCROLL:     peerCanvas.scroll(get16(a), get16(a + 2), get16(a + 4)); break;
+    case DRAW_TEXT: {
+      uint8_t len = a[10];
+      if (a[4] >= DrawRecorder::fontCount() || p + len > end) { ok = false; break; }
+      peerCanvas.setFont(DrawRecorder::font(a[4]));
+      peerCanvas.setTextSize(a[5]);
+      peerCanvas.setTextColor(get16(a + 6), get16(a + 8));
+      peerCanvas.setTextWrap(false);
+      peerCanvas.setCursor(get16(a), get16(a + 2));
+      for (uint8_t i = 0; i < len; i++) peerCanvas.write(p[i]);
+      p += len;
+    } break;
+    }
+  }
+  peerCanvas.setClip(0, 0, 0, 0);
+  return ok;
+}
+#endif
+
+// Decode into the peer's copy of the screen like the web page does
+bool EspLoopback::decodeFrame(uint8_t codec, const uint8_t *data, uint32_t len) {
+  switch (codec) {
+  case FRAME_TYPE_RAW:
+    if (len != UNCOMPRESSED_BUFFER_SIZE) return false;
+    memcpy(peerFrame, data, len);
+    return true;
+
+  case FRAME_TYPE_RLE: {
+    size_t out = 0;
+    for (uint32_t i = 0; i + 2 < len; i += 3) {
+      uint8_t run = data[i + 2];
+      if (out + run * COLOR_DEPTH > UNCOMPRESSED_BUFFER_SIZE) return false;
+      while (run--) {
+        peerFrame[out++] = data[i];
+        peerFrame[out++] = data[i + 1];
+      }
+    }
+    return out == UNCOMPRESSED_BUFFER_SIZE;
+  }
+
+  case FRAME_TYPE_DEF:
+    return tinfl_decompress_mem_to_mem(peerFrame, UNCOMPRESSED_BUFFER_SIZE, data, len, 0) == UNCOMPRESSED_BUFFER_SIZE;
+
+  case FRAME_TYPE_TIL: {
+    size_t n = tinfl_decompress_mem_to_mem(tileScratch, sizeof(tileScratch), data, len, 0);
+    if (n == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED) return false;
+    return applyTiles(tileScratch, n);
+  }
+
+  case FRAME_TYPE_PAL: {
+    size_t n = tinfl_decompress_mem_to_mem(tileScratch, sizeof(tileScratch), data, len, 0);
+    if (n == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED || n < 3) return false;
+    uint8_t bits = tileScratch[0];
+    uint16_t count = tileScratch[1] | (tileScratch[2] << 8);
+    if ((bits != 4 && bits != 8) || count == 0 || count > PAL_COLORS_MAX) return false;
+    const uint8_t *colors = tileScratch + 3;
+    const uint8_t *index = colors + count * COLOR_DEPTH;
+    const uint32_t pixels = SCREEN_WIDTH * SCREEN_HEIGHT;
+    size_t used = 3 + count * COLOR_DEPTH + pixels * bits / 8;
+    if (n < used) return false;
+    for (uint32_t i = 0; i < pixels; i++) {
+      uint8_t k = (bits == 8) ? index[i] : ((i & 1) ? (index[i >> 1] & 0x0F) : (index[i >> 1] >> 4));
+      if (k >= count) return false;
+      peerFrame[i * 2] = colors[k * 2];
+      peerFrame[i * 2 + 1] = colors[k * 2 + 1];
+    }
+    return applyTiles(tileScratch + used, n - used);
+  }
+
+#ifdef ENABLE_TFT_DRAWCMDS
+  case FRAME_TYPE_CMD: {
+    size_t n = tinfl_decompress_mem_to_mem(tileScratch, sizeof(tileScratch), data, len, 0);
+    if (n == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED || n < 4) return false;
+    uint32_t size = tileScratch[0] | (tileScratch[1] << 8) | (tileScratch[2] << 16) | ((uint32_t)tileScratch[3] << 24);
+    if (4 + size > n || !replayCommands(tileScratch + 4, size)) return false;
+    return applyTiles(tileScratch + 4 + size, n - 4 - size);
+  }
+#endif
+
+  default:
+    return false;
+  }
+}
+
+// Queue a message for the Teensy, dropped if the Teensy stopped reading
+void EspLoopback::send(uint8_t type, const uint8_t *data, uint16_t len) {
+  uint8_t msg[LINK_HEADER_SIZE + LINK_RX_PAYLOAD_MAX + LINK_CRC_SIZE] = { LINK_SYNC0, LINK_SYNC1, type,
+    (uint8_t)(txSeq & 0xFF), (uint8_t)(txSeq >> 8), (uint8_t)(len & 0xFF), (uint8_t)(len >> 8), 0, 0 };
+  txSeq++;
+  if (len > LINK_RX_PAYLOAD_MAX) return;
+  if (len) memcpy(msg + LINK_HEADER_SIZE, data, len);
+  uint32_t crc = mz_crc32(MZ_CRC32_INIT, msg + 2, LINK_HEADER_SIZE - 2 + len);
+  uint16_t size = LINK_HEADER_SIZE + len;
+  msg[size++] = crc & 0xFF;
+  msg[size++] = (crc >> 8) & 0xFF;
+  msg[size++] = (crc >> 16) & 0xFF;
+  msg[size++] = (crc >> 24) & 0xFF;
+
+  if (rxCount + size > LOOPBACK_RX_FIFO) {
+    errors++;
+    return;
+  }
+  for (uint16_t i = 0; i < size; i++) {
+    rxFifo[(rxHead + rxCount) % LOOPBACK_RX_FIFO] = msg[i];
+    rxCount++;
+  }
+}
+
+void EspLoopback::report() {
+  unsigned long ms = millis();
+  uint32_t frames = keyframes + deltas;
+  uint32_t elapsed = ms - lastReportMs;
+  SERIAL_DEBUG.printf("Loopback: %lu key %lu delta %lu resync %lu err %lu stall, %lu KB/s\n",
+                      keyframes, deltas, resyncs, errors, stalls, elapsed ? bytes / elapsed : 0);
+  SERIAL_DEBUG.printf("Loopback: frame %lu/%lu us avg/max, touch to frame %lu/%lu ms avg/max\n",
+                      frames ? latencySumUs / frames : 0, latencyMaxUs,
+                      touches ? touchSumMs / touches : 0, touchMaxMs);
+  keyframesTotal += keyframes;
+  deltasTotal += deltas;
+  resyncsTotal += resyncs;
+  errorsTotal += errors;
+  keyframes = deltas = resyncs = errors = stalls = 0;
+  bytes = 0;
+  latencySumUs = latencyMaxUs = 0;
+  touchSumMs = touchMaxMs = touches = 0;
+  lastReportMs = ms;
+}
+
+EspLoopback espLoopback;
+
+#endif
@@ -0,0 +1,99 @@
+// =====================================================
+// EspLoopback.h
+// Stand-in for the ESP32-S3 on the mirror link
+//
+// With ENABLE_ESP_LOOPBACK (Display.h) SERIAL_ESP is this Stream instead of the
+// USB host serial. Behind it a fake ESP32-S3 runs the same protocol as the real
+// one: HELLO/IP/CLIENT handshake, frame CRC and seq checks, decoding of every
+// codec into its own copy of the screen, ACK and RESYNC, and scripted touches.
+// Bytes from the Teensy drain at a set link rate so timing looks like USB.
+// Frame latency, throughput and stalls are printed on SERIAL_DEBUG, which
+// lets the whole mirror path run without the ESP32-S3 or a web client.
+
+#ifndef ESP_LOOPBACK_H
+#define ESP_LOOPBACK_H
+
+#include <Arduino.h>
+
+#define LOOPBACK_BYTES_PER_MS  1000  // link rate, about USB full speed
+#define LOOPBACK_TX_FIFO       4096  // Teensy to peer, what availableForWrite() reports
+#define LOOPBACK_RX_FIFO        256  // peer to Teensy
+#define LOOPBACK_TOUCH_MS      5000  // scripted touch interval, 0 for none
+#define LOOPBACK_CORRUPT_EVERY    0  // corrupt one byte of every Nth frame to exercise RESYNC, 0 for none
+#define LOOPBACK_STALL_MS      2000  // no frame this long after a touch, or a message stuck half way
+#define LOOPBACK_REPORT_MS    10000
+
+class EspLoopback : public Stream {
+  public:
+    // Stream, as used on SERIAL_ESP
+    int available();
+    int read();
+    int peek();
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    int availableForWrite();
+    void flush() {}
+    using Print::write;
+
+    // For the host test (MirrorHost/): the peer's copy of the screen, totals
+    // since the start, and a bit flip in the middle of the next frame
+    const uint8_t *screen();
+    uint32_t keyframeCount() { return keyframesTotal + keyframes; }
+    uint32_t deltaCount() { return deltasTotal + deltas; }
+    uint32_t resyncCount() { return resyncsTotal + resyncs; }
+    uint32_t errorCount() { return errorsTotal + errors; }
+    void corruptNextFrame() { corruptNext = true; }
+
+  private:
+    void service();
+    void receive(uint8_t c);
+    void handleMessage();
+    bool decodeFrame(uint8_t codec, const uint8_t *data, uint32_t len);
+    void send(uint8_t type, const uint8_t *payload, uint16_t len);
+    void report();
+
+    // Teensy -> peer, drained at the link rate
+    uint8_t  txFifo[LOOPBACK_TX_FIFO];
+    uint16_t txHead = 0, txCount = 0;
+    uint32_t lastDrainUs = 0;
+    float    drainCredit = 0;
+
+    // peer -> Teensy
+    uint8_t  rxFifo[LOOPBACK_RX_FIFO];
+    uint16_t rxHead = 0, rxCount = 0;
+
+    // message being received from the Teensy
+    uint8_t  header[9];
+    uint32_t msgPos = 0;
+    uint32_t msgLen = 0;
+    uint32_t msgCrc = 0;
+    uint8_t  crcBytes[4];
+    unsigned long msgStartMs = 0;
+    uint32_t frameStartUs = 0;        // first byte of a frame left the Teensy
+    uint16_t txSeq = 0;               // peer's own messages
+    uint16_t lastSeq = 0;
+    bool     seqValid = false;
+
+    // peer state
+    bool     connected = false;       // handshake done, "web client" attached
+    bool     needKeyframe = true;
+    uint32_t framesSeen = 0;
+    bool     corruptNext = false;
+
+    // scripted touches
+    uint8_t  touchStep = 0;
+    unsigned long lastTouchMs = 0;
+    unsigned long touchSentMs = 0;    // waiting for the frame that shows it, 0 if none
+
+    // statistics since the last report
+    uint32_t keyframes = 0, deltas = 0, resyncs = 0, errors = 0, stalls = 0;
+    uint32_t keyframesTotal = 0, deltasTotal = 0, resyncsTotal = 0, errorsTotal = 0;
+    uint32_t bytes = 0;
+    uint32_t latencySumUs = 0, latencyMaxUs = 0;
+    uint32_t touchSumMs = 0, touchMaxMs = 0, touches = 0;
+    unsigned long lastReportMs = 0;
+};
+
+extern EspLoopback espLoopback;
+
+#endif
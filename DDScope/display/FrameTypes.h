@@ -0,0 +1,22 @@
+// =====================================================
+// FrameTypes.h
+// Frame type byte sent ahead of each mirrored screen frame
+//
+// Shared by Display.h and WifiDisplay.h, which is included ahead of Display.h
+// in some translation units.
+
+#ifndef FRAME_TYPES_H
+#define FRAME_TYPES_H
+
+#define FRAME_TYPE_RAW  0x00 // Raw frame of 307600 bytes
+#define FRAME_TYPE_RLE  0x01 // Run Length encoding
+#define FRAME_TYPE_LZ4  0x02 // removed this because native JavaScript support limited
+#define FRAME_TYPE_DIF  0x03 // Differential pixel encoding...removed due to complexity
+#define FRAME_TYPE_DEF  0x04 // Deflate compression is a lossless data compression algorithm 
+                             // that combines the LZ77 algorithm and Huffman coding to 
+                             // reduce the size of data. Has Native browser support.
+#define FRAME_TYPE_TIL  0x05 // Deflated 16x16 tiles that changed since the last frame
+#define FRAME_TYPE_PAL  0x06 // Deflated palette and 4/8-bit indices, RGB565 tiles for pictures
+#define FRAME_TYPE_CMD  0x07 // Deflated GFX draw commands since the last frame, RGB565 tiles for bitmaps
+
+#endif
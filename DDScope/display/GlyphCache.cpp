@@ -0,0 +1,191 @@
+// =====================================================
+// GlyphCache.cpp
+//
+// Pre-rasterized RGB565 glyph atlases in PSRAM
+
+#include "Display.h"
+#include "GlyphCache.h"
+#include "DrawRecorder.h"
+
+// atlases go to PSRAM, the line being composed stays in faster DMAMEM
+EXTMEM static uint16_t glyphAtlas[GLYPH_CACHE_SLOTS][GLYPH_SLOT_PIXELS];
+DMAMEM static uint16_t glyphStrip[GLYPH_STRIP_PIXELS];
+
+// Find the atlas for this font and color pair, expanding a new one into the least recently used slot if needed
+GlyphCache::Slot* GlyphCache::getSlot(const GFXfont* font, uint16_t fg, uint16_t bg) {
+  uint8_t lru = 0;
+  for (uint8_t i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    if (slots[i].font == font && slots[i].fg == fg && slots[i].bg == bg) {
+      slots[i].lastUse = ++useCount;
+      return &slots[i];
+    }
+    if (slots[i].lastUse < slots[lru].lastUse) lru = i;
+  }
+  if (!fillSlot(lru, font, fg, bg)) return NULL;
+  slots[lru].lastUse = ++useCount;
+  return &slots[lru];
+}
+
+// Expand every glyph of the font to RGB565, same bit walk as Adafruit_GFX::drawChar()
+bool GlyphCache::fillSlot(uint8_t index, const GFXfont* font, uint16_t fg, uint16_t bg) {
+  Slot* s = &slots[index];
+  s->font = NULL; // invalid until completely filled
+
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last  = pgm_read_byte(&font->last);
+  if (last - first + 1 > GLYPH_MAX_CHARS) return false;
+
+  const uint8_t* bitmap = (const uint8_t*)pgm_read_ptr(&font->bitmap);
+  uint16_t* atlas = glyphAtlas[index];
+  uint32_t pos = 0;
+
+  for (uint8_t c = first; c <= last; c++) {
+    GFXglyph* glyph = ((GFXglyph*)pgm_read_ptr(&font->glyph)) + (c - first);
+    uint16_t bo = pgm_read_word(&glyph->bitmapOffset);
+    uint8_t  w  = pgm_read_byte(&glyph->width);
+    uint8_t  h  = pgm_read_byte(&glyph->height);
+
+    if (pos + w*h > GLYPH_SLOT_PIXELS) {
+      VLF("MSG: GlyphCache, font too large for atlas");
+      return false;
+    }
+    s->offset[c - first] = pos;
+
+    uint8_t bits = 0, bit = 0;
+    for (uint8_t yy = 0; yy < h; yy++) {
+      for (uint8_t xx = 0; xx < w; xx++) {
+        if (!(bit++ & 7)) bits = pgm_read_byte(&bitmap[bo++]);
+        atlas[pos++] = (bits & 0x80) ? fg : bg;
+        bits <<= 1;
+      }
+    }
+  }
+  s->fg     = fg;
+  s->bg     = bg;
+  s->font   = font;
+  return true;
+}
+
+// Compose a string into dst from the atlas, clipping every glyph to the buffer
+bool GlyphCache::compose(uint16_t* dst, uint16_t dstW, uint16_t dstH, int16_t cx, int16_t cy,
+                         const char* text, const GFXfont* font, uint16_t fg, uint16_t bg) {
+  if (font == NULL) return false;
+  Slot* s = getSlot(font, fg, bg);
+  if (s == NULL) return false;
+
+  for (uint32_t i = 0; i < (uint32_t)dstW*dstH; i++) dst[i] = bg;
+
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last  = pgm_read_byte(&font->last);
+  const uint16_t* atlas = glyphAtlas[s - slots];
+
+  for (const char* p = text; *p; p++) {
+    uint8_t c = *p;
+    if (c < first || c > last) continue;
+    GFXglyph* glyph = ((GFXglyph*)pgm_read_ptr(&font->glyph)) + (c - first);
+    uint8_t w  = pgm_read_byte(&glyph->width);
+    uint8_t h  = pgm_read_byte(&glyph->height);
+    int16_t x0 = cx + (int8_t)pgm_read_byte(&glyph->xOffset);
+    int16_t y0 = cy + (int8_t)pgm_read_byte(&glyph->yOffset);
+    const uint16_t* g = atlas + s->offset[c - first];
+
+    for (uint8_t yy = 0; yy < h; yy++) {
+      int16_t row = y0 + yy;
+      if (row < 0 || row >= dstH) continue;
+      for (uint8_t xx = 0; xx < w; xx++) {
+        int16_t col = x0 + xx;
+        if (col < 0 || col >= dstW) continue;
+        dst[row*dstW + col] = g[yy*w + xx];
+      }
+    }
+    cx += pgm_read_byte(&glyph->xAdvance);
+  }
+  return true;
+}
+
+// Text extent relative to the cursor
+bool GlyphCache::textBounds(const char* text, const GFXfont* font, uint16_t* w, int16_t* top, int16_t* bottom) {
+  if (font == NULL) return false;
+
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last  = pgm_read_byte(&font->last);
+  GFXglyph* glyphs = (GFXglyph*)pgm_read_ptr(&font->glyph);
+
+  // vertical extent is over the whole font so that every field drawn with it has the same height
+  int16_t t = 0, b = 0;
+  for (uint8_t c = first; c <= last; c++) {
+    int8_t  yo = pgm_read_byte(&glyphs[c - first].yOffset);
+    uint8_t h  = pgm_read_byte(&glyphs[c - first].height);
+    if (yo < t) t = yo;
+    if (yo + h > b) b = yo + h;
+  }
+
+  // a glyph can reach past its advance, italics and wide last letters, keep it in the box
+  int16_t width = 0, right = 0;
+  for (const char* p = text; *p; p++) {
+    uint8_t c = *p;
+    if (c < first || c > last) continue;
+    int16_t edge = width + (int8_t)pgm_read_byte(&glyphs[c - first].xOffset) + pgm_read_byte(&glyphs[c - first].width);
+    if (edge > right) right = edge;
+    width += pgm_read_byte(&glyphs[c - first].xAdvance);
+  }
+  *w      = max(width, right);
+  *top    = t;
+  *bottom = b;
+  return true;
+}
+
+// Draw opaque text in one address window
+bool GlyphCache::drawText(int16_t x, int16_t y, const char* text, const GFXfont* font, uint16_t fg, uint16_t bg) {
+  uint16_t w; int16_t top, bottom;
+  if (!textBounds(text, font, &w, &top, &bottom)) return false;
+  uint16_t h = bottom - top;
+  if (w == 0) return true;
+  if ((uint32_t)w*h > GLYPH_STRIP_PIXELS) return false;
+  if (x < 0 || y + top < 0 || x + w > tft.width() || y + bottom > tft.height()) return false;
+
+  if (!compose(glyphStrip, w, h, 0, -top, text, font, fg, bg)) return false;
+#ifdef ENABLE_TFT_DRAWCMDS
+  // the mirror gets the box and the string, not the strip
+  drawRecorder.pause();
+  tft.writeRect(x, y + top, w, h, glyphStrip);
+  drawRecorder.resume();
+  drawRecorder.fill(x, y + top, w, h, bg);
+  drawRecorder.text(x, y, font, 1, fg, fg, text, strlen(text), -1);
+#else
+  tft.writeRect(x, y + top, w, h, glyphStrip);
+#endif
+  return true;
+}
+
+// Draw opaque text into a fixed box in one address window
+bool GlyphCache::drawTextBox(int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t cx, int16_t cy,
+                             const char* text, const GFXfont* font, uint16_t fg, uint16_t bg) {
+  if ((uint32_t)w*h > GLYPH_STRIP_PIXELS || w == 0 || h == 0) return false;
+  if (x < 0 || y < 0 || x + w > tft.width() || y + h > tft.height()) return false;
+
+  if (!compose(glyphStrip, w, h, cx - x, cy - y, text, font, fg, bg)) return false;
+#ifdef ENABLE_TFT_DRAWCMDS
+  // the mirror gets the box and the clipped string, not the strip
+  drawRecorder.pause();
+  tft.writeRect(x, y, w, h, glyphStrip);
+  drawRecorder.resume();
+  drawRecorder.fill(x, y, w, h, bg);
+  drawRecorder.clip(x, y, w, h);
+  drawRecorder.text(cx, cy, font, 1, fg, fg, text, strlen(text), -1);
+  drawRecorder.clip(0, 0, 0, 0);
+#else
+  tft.writeRect(x, y, w, h, glyphStrip);
+#endif
+  return true;
+}
+
+// Themes change fg/bg of most text, so just start over
+void GlyphCache::invalidate() {
+  for (uint8_t i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    slots[i].font = NULL;
+    slots[i].lastUse = 0;
+  }
+}
+
+GlyphCache glyphCache;
@@ -0,0 +1,66 @@
+// =====================================================
+// GlyphCache.h
+// Pre-rasterized RGB565 glyph atlases for the GFX fonts
+//
+// Adafruit_GFX draws custom font text one set pixel at a time and the
+// ILI9486 driver turns every one of those into its own address window.
+// The cache expands each glyph of a font once, for a given foreground and
+// background color, so a whole string can be composed in RAM and pushed to
+// the TFT in a single address window.
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+#define GLYPH_CACHE_SLOTS         6  // number of (font, fg, bg) atlases kept
+#define GLYPH_SLOT_PIXELS     24576  // 48KB of RGB565 per atlas, fits FreeSansBold12pt7b
+#define GLYPH_MAX_CHARS          96  // 0x20..0x7F
+#define GLYPH_STRIP_PIXELS  (320*32) // one line of the widest/tallest font used
+
+class GlyphCache {
+  public:
+    // Draw text with its baseline at (x, y) like tft.setCursor() + tft.print(),
+    // but opaque: the text extent box is filled with bg, so bg has to be the color
+    // already under all of that box. Returns false when the text can't be handled
+    // here (default font, too wide), caller should fall back.
+    bool drawText(int16_t x, int16_t y, const char* text, const GFXfont* font, uint16_t fg, uint16_t bg);
+
+    // Same, but the opaque box is exactly x, y, w, h and the text is clipped to it,
+    // for fields with a fixed background rectangle. (cx, cy) is the cursor on the TFT.
+    bool drawTextBox(int16_t x, int16_t y, uint16_t w, uint16_t h, int16_t cx, int16_t cy,
+                     const char* text, const GFXfont* font, uint16_t fg, uint16_t bg);
+
+    // Compose text into a caller supplied RGB565 buffer of dstW x dstH with the
+    // cursor (baseline) at (cx, cy) inside that buffer; buffer is filled with bg first
+    bool compose(uint16_t* dst, uint16_t dstW, uint16_t dstH, int16_t cx, int16_t cy,
+                 const char* text, const GFXfont* font, uint16_t fg, uint16_t bg);
+
+    // Extent of text relative to the cursor: width in pixels up to the last advance or the
+    // right edge of the last glyph, whichever is further, and the rows above (top, negative)
+    // and below (bottom) the baseline covered by any glyph of the font
+    bool textBounds(const char* text, const GFXfont* font, uint16_t* w, int16_t* top, int16_t* bottom);
+
+    // Drop all atlases, used when the color theme changes
+    void invalidate();
+
+  private:
+    struct Slot {
+      const GFXfont* font;
+      uint16_t  fg;
+      uint16_t  bg;
+      uint32_t  lastUse;
+      uint16_t  offset[GLYPH_MAX_CHARS]; // pixel offset of each glyph in the atlas
+    };
+
+    Slot* getSlot(const GFXfont* font, uint16_t fg, uint16_t bg);
+    bool  fillSlot(uint8_t index, const GFXfont* font, uint16_t fg, uint16_t bg);
+
+    Slot     slots[GLYPH_CACHE_SLOTS];
+    uint32_t useCount = 0;
+};
+
+extern GlyphCache glyphCache;
+
+#endif
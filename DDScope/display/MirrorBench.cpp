@@ -0,0 +1,136 @@
+// =====================================================
+// MirrorBench.cpp
+//
+// WiFi mirror codec benchmark over captured screens, see MirrorBench.h
+
+#include "Display.h"
+#include "MirrorBench.h"
+#include "miniz.h"
+
+#ifdef ENABLE_MIRROR_BENCHMARK
+
+typedef struct BenchCodec {
+  const char* name;
+  int         level;   // deflate level
+} BenchCodec;
+
+static const BenchCodec benchCodecs[] = {
+  { "RAW",  0 },
+  { "RLE",  0 },
+  { "DEF1", MZ_BEST_SPEED },
+  { "DEF3", 3 },
+  { "DEF6", MZ_DEFAULT_COMPRESSION },
+  { "DEF9", MZ_BEST_COMPRESSION },
+#ifdef ENABLE_TFT_PAL_FRAMES
+  { "PAL1", MZ_BEST_SPEED },
+  { "PAL6", MZ_DEFAULT_COMPRESSION },
+#endif
+};
+#define BENCH_FIRST_PAL 6
+#define BENCH_CODECS (sizeof(benchCodecs) / sizeof(benchCodecs[0]))
+
+static bool isCapture(File& entry) {
+  const char* name = entry.name();
+  size_t len = strlen(name);
+  return !entry.isDirectory() && entry.size() == UNCOMPRESSED_BUFFER_SIZE &&
+         strncmp(name, "tft_", 4) == 0 && len > 8 && strcmp(name + len - 8, "_log.bin") == 0;
+}
+
+static size_t runCodec(uint8_t codec) {
+  if (codec == 0) {
+    memcpy(compressedBuffer, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+    return UNCOMPRESSED_BUFFER_SIZE;
+  }
+  if (codec == 1) return wifiDisplay.compressWithRLE();
+#ifdef ENABLE_TFT_PAL_FRAMES
+  if (codec >= BENCH_FIRST_PAL) return wifiDisplay.compressPalette(benchCodecs[codec].level);
+#endif
+  return wifiDisplay.compressWithDeflate(benchCodecs[codec].level);
+}
+
+void mirrorBenchmark(void) {
+  VLF("MSG: Mirror benchmark, starting");
+  File root = SD.open("/");
+  if (!root) {
+    VLF("MSG: Mirror benchmark, no SD card");
+    return;
+  }
+  if (SD.exists(BENCH_RESULTS_FILE)) SD.remove(BENCH_RESULTS_FILE);
+  File results = SD.open(BENCH_RESULTS_FILE, FILE_WRITE);
+
+  char line[96];
+  snprintf(line, sizeof(line), "file,codec,bytes,ratio,us,cycles,MB/s");
+  SERIAL_DEBUG.println(line);
+  if (results) results.println(line);
+
+  uint32_t frames = 0;
+  uint32_t finished[BENCH_CODECS] = {0};  // frames the codec didn't give up on
+  uint64_t totalBytes[BENCH_CODECS] = {0};
+  uint64_t totalCycles[BENCH_CODECS] = {0};
+
+  for (File entry = root.openNextFile(); entry; entry = root.openNextFile()) {
+    if (!isCapture(entry)) {
+      entry.close();
+      continue;
+    }
+    char name[64];
+    strlcpy(name, entry.name(), sizeof(name));
+    size_t got = entry.read(uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+    entry.close();
+    if (got != UNCOMPRESSED_BUFFER_SIZE) continue;
+    frames++;
+
+    for (uint8_t c = 0; c < BENCH_CODECS; c++) {
+      size_t bytes = 0;
+      uint32_t bestCycles = UINT32_MAX;
+      for (uint8_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = ARM_DWT_CYCCNT;
+        bytes = runCodec(c);
+        uint32_t cycles = ARM_DWT_CYCCNT - start;
+        if (cycles < bestCycles) bestCycles = cycles;
+      }
+      uint32_t us = bestCycles / (F_CPU_ACTUAL / 1000000);
+      // bytes 0 means the codec gave up (RLE output larger than the buffer,
+      // mostly pictures for the palette), kept out of the averages
+      if (bytes) {
+        finished[c]++;
+        totalBytes[c] += bytes;
+        totalCycles[c] += bestCycles;
+      }
+
+      snprintf(line, sizeof(line), "%s,%s,%u,%.1f,%lu,%lu,%.1f", name, benchCodecs[c].name,
+               (unsigned)bytes, bytes ? (float)UNCOMPRESSED_BUFFER_SIZE / bytes : 0.0f,
+               us, bestCycles, us ? (float)UNCOMPRESSED_BUFFER_SIZE / us : 0.0f);
+      SERIAL_DEBUG.println(line);
+      if (results) results.println(line);
+    }
+  }
+  root.close();
+
+  // averages over the frames each codec finished, and how many it gave up on
+  for (uint8_t c = 0; c < BENCH_CODECS && frames; c++) {
+    if (finished[c]) {
+      uint32_t bytes = totalBytes[c] / finished[c];
+      uint32_t cycles = totalCycles[c] / finished[c];
+      uint32_t us = cycles / (F_CPU_ACTUAL / 1000000);
+      snprintf(line, sizeof(line), "average,%s,%lu,%.1f,%lu,%lu,%.1f", benchCodecs[c].name,
+               bytes, (float)UNCOMPRESSED_BUFFER_SIZE / bytes,
+               us, cycles, us ? (float)UNCOMPRESSED_BUFFER_SIZE / us : 0.0f);
+      SERIAL_DEBUG.println(line);
+      if (results) results.println(line);
+    }
+    if (finished[c] < frames) {
+      snprintf(line, sizeof(line), "gave up,%s,%lu frames", benchCodecs[c].name, frames - finished[c]);
+      SERIAL_DEBUG.println(line);
+      if (results) results.println(line);
+    }
+  }
+  if (results) results.close();
+
+  // the buffers held corpus frames, the mirror starts over from a keyframe
+  memset(uncompressedBuffer, 0, UNCOMPRESSED_BUFFER_SIZE);
+  wifiDisplay.frameDirty = true;
+  VF("MSG: Mirror benchmark, frames = "); VL(frames);
+}
+
+#endif
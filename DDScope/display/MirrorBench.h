@@ -0,0 +1,24 @@
+// =====================================================
+// MirrorBench.h
+// WiFi mirror codec benchmark over captured screens
+//
+// Runs every mirror codec over each full frame capture on the SD card
+// (tft_<screen>_log.bin, 320x480 big-endian RGB565 as written by
+// saveBufferToSD(), or made from ScreenImages/ with png_to_capture.py) and
+// reports size, time and CPU cycles per frame, so codec choices rest on
+// numbers anyone can reproduce with the same files.
+
+#ifndef MIRROR_BENCH_H
+#define MIRROR_BENCH_H
+
+#include <Arduino.h>
+
+#define BENCH_RESULTS_FILE  "/mirror_bench.csv"
+#define BENCH_REPEAT        3   // runs per codec and frame, the fastest counts
+
+// Benchmark all captures found in the SD root, results on SERIAL_DEBUG and in
+// BENCH_RESULTS_FILE. Uses the mirror buffers, so run it before the ESP32-S3
+// link is up.
+void mirrorBenchmark(void);
+
+#endif
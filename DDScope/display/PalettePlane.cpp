@@ -0,0 +1,130 @@
+// =====================================================
+// PalettePlane.cpp
+//
+// 4-bit palette index shadow of the TFT, two pixels per byte,
+// even x in the low nibble
+
+#include "Display.h"
+#include "PalettePlane.h"
+
+EXTMEM static uint8_t plane[PALETTE_PLANE_BYTES];
+DMAMEM static uint16_t flushStrip[TFTWIDTH*PALETTE_FLUSH_ROWS];
+
+void PalettePlane::setRoles(const uint16_t* roleColors) {
+  for (uint8_t i = 0; i < THEME_ROLES; i++) palette[i] = roleColors[i];
+  lastIndex = 0xFF;
+}
+
+// Palette entry for a color, roles are searched first. A color that doesn't
+// fit any more invalidates the plane until the next full screen fill.
+uint8_t PalettePlane::indexOf(uint16_t color) {
+  if (lastIndex != 0xFF && color == lastColor) return lastIndex;
+  uint8_t i = 0;
+  while (i < used && palette[i] != color) i++;
+  if (i == used) {
+    if (used == PALETTE_SIZE) { overflow = true; return 0; }
+    palette[used++] = color;
+  }
+  lastColor = color;
+  lastIndex = i;
+  return i;
+}
+
+void PalettePlane::setSpan(uint16_t y, uint16_t xa, uint16_t xb, uint8_t index) {
+  uint8_t* row = plane + y*(TFTWIDTH/2);
+  if (xa & 1) {
+    row[xa >> 1] = (row[xa >> 1] & 0x0F) | (index << 4);
+    if (xa == xb) return;
+    xa++;
+  }
+  if (!(xb & 1)) {
+    row[xb >> 1] = (row[xb >> 1] & 0xF0) | index;
+    if (xa == xb) return;
+    xb--;
+  }
+  memset(row + (xa >> 1), index*0x11, (xb - xa + 1) >> 1);
+}
+
+void PalettePlane::window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+  if (x1 >= TFTWIDTH)  x1 = TFTWIDTH - 1;
+  if (y1 >= TFTHEIGHT) y1 = TFTHEIGHT - 1;
+  winX0 = curX = x0;
+  winY0 = curY = y0;
+  winX1 = x1;
+  winY1 = y1;
+}
+
+// Move the cursor like the panel does, wrapping to the next row of the window
+void PalettePlane::advance(uint32_t num) {
+  uint16_t width = winX1 - winX0 + 1;
+  curX += num % width;
+  curY += num / width;
+  if (curX > winX1) { curX -= width; curY++; }
+}
+
+void PalettePlane::push(uint16_t color) {
+  if (flushing || curY > winY1 || curX >= TFTWIDTH) return;
+  setSpan(curY, curX, curX, indexOf(color));
+  advance(1);
+}
+
+void PalettePlane::pushFill(uint16_t color, uint32_t num) {
+  if (flushing || winX0 > winX1 || winY0 > winY1) return;
+
+  // a full screen fill starts a new screen, forget the colors of the old one
+  if (winX0 == 0 && winY0 == 0 && winX1 == TFTWIDTH - 1 && winY1 == TFTHEIGHT - 1 &&
+      num >= (uint32_t)TFTWIDTH*TFTHEIGHT) {
+    used = THEME_ROLES;
+    lastIndex = 0xFF;
+    overflow = false;
+  }
+
+  uint8_t index = indexOf(color);
+  while (num && curY <= winY1) {
+    uint32_t span = winX1 - curX + 1;
+    if (span > num) span = num;
+    setSpan(curY, curX, curX + span - 1, index);
+    advance(span);
+    num -= span;
+  }
+}
+
+void PalettePlane::pushPixels(const uint16_t* pixels, uint32_t num) {
+  if (flushing || winX0 > winX1 || winY0 > winY1) return;
+  for (uint32_t i = 0; i < num && curY <= winY1; i++) {
+    setSpan(curY, curX, curX, indexOf(pixels[i]));
+    if (++curX > winX1) { curX = winX0; curY++; }
+  }
+}
+
+// Rows coming into view keep old indexes until the caller draws them
+void PalettePlane::scroll(uint16_t top, uint16_t height, int16_t lines) {
+  uint32_t n = abs(lines);
+  if (n == 0 || n >= height || top + height > TFTHEIGHT) return;
+  uint8_t* band = plane + top*(TFTWIDTH/2);
+  if (lines > 0)
+    memmove(band, band + n*(TFTWIDTH/2), (height - n)*(TFTWIDTH/2));
+  else
+    memmove(band + n*(TFTWIDTH/2), band, (height - n)*(TFTWIDTH/2));
+}
+
+// Expand the plane through the palette a strip of rows at a time
+bool PalettePlane::flush() {
+  if (overflow) return false;
+
+  flushing = true; // these pixels are already in the plane
+  for (uint16_t y = 0; y < TFTHEIGHT; y += PALETTE_FLUSH_ROWS) {
+    uint16_t rows = min(PALETTE_FLUSH_ROWS, TFTHEIGHT - y);
+    const uint8_t* src = plane + y*(TFTWIDTH/2);
+    uint16_t* dst = flushStrip;
+    for (uint32_t i = 0; i < (uint32_t)rows*TFTWIDTH/2; i++) {
+      *dst++ = palette[src[i] & 0x0F];
+      *dst++ = palette[src[i] >> 4];
+    }
+    tft.writeRect(0, y, TFTWIDTH, rows, flushStrip);
+  }
+  flushing = false;
+  return true;
+}
+
+PalettePlane palettePlane;
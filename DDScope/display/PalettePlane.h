@@ -0,0 +1,71 @@
+// =====================================================
+// PalettePlane.h
+// 4-bit palette index shadow of the TFT
+//
+// The driver reports every pixel it sends to the panel. The plane keeps a
+// 4-bit index per pixel into a 16 entry palette whose first entries are the
+// theme color roles (page background, button fill, text, ...) and the rest
+// are the other colors seen since the last full screen fill. A theme change
+// only has to swap the role colors and flush() the plane back to the panel.
+
+#ifndef PALETTE_PLANE_H
+#define PALETTE_PLANE_H
+
+#include <Arduino.h>
+
+#define PALETTE_SIZE          16
+#define PALETTE_PLANE_BYTES   (320*480/2)
+#define PALETTE_FLUSH_ROWS    16   // rows expanded to RGB565 per writeRect()
+
+// Theme color roles, palette entries 0..THEME_ROLES-1
+typedef enum {
+  ROLE_PG_BACKGROUND,
+  ROLE_BUT_BACKGROUND,
+  ROLE_BUT_ON_BACKGROUND,
+  ROLE_TEXT,
+  ROLE_BUT_OUTLINE,
+  THEME_ROLES
+} ThemeRole;
+
+class PalettePlane {
+  public:
+    // Set the colors of the theme roles, pixels already drawn keep their role
+    void setRoles(const uint16_t* roleColors);
+
+    // Driver hooks: address window, then pixels in window order
+    void window(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    void push(uint16_t color);
+    void pushFill(uint16_t color, uint32_t num);
+    void pushPixels(const uint16_t* pixels, uint32_t num);
+
+    // Follow a hardware scroll of rows top..top+height-1, > 0 moves them up
+    void scroll(uint16_t top, uint16_t height, int16_t lines);
+
+    // Redraw the whole panel from the plane with the current palette. Returns
+    // false if the screen used more colors than the palette holds, then the
+    // screen has to be redrawn instead.
+    bool flush();
+
+    // The plane no longer matches the panel until the next full screen fill
+    bool isValid() { return !overflow; }
+
+  private:
+    uint8_t indexOf(uint16_t color);
+    void    setSpan(uint16_t y, uint16_t xa, uint16_t xb, uint8_t index);
+    void    advance(uint32_t num);
+
+    uint16_t palette[PALETTE_SIZE];
+    uint8_t  used = THEME_ROLES;
+    bool     overflow = true;   // nothing captured yet
+    bool     flushing = false;
+
+    uint16_t lastColor = 0;
+    uint8_t  lastIndex = 0xFF;
+
+    uint16_t winX0 = 0, winY0 = 0, winX1 = 0, winY1 = 0;
+    uint16_t curX = 0, curY = 0;
+};
+
+extern PalettePlane palettePlane;
+
+#endif
@@ -0,0 +1,179 @@
+// =====================================================
+// SdWriter.cpp
+//
+// Background SD card writer, see SdWriter.h
+
+#include "Display.h"
+#include "SdWriter.h"
+
+EXTMEM static uint8_t recRing[REC_RING_SIZE];
+EXTMEM static uint8_t capBuffer[UNCOMPRESSED_BUFFER_SIZE];
+
+// ==================== Session Recording ====================
+bool SdWriter::startRecording() {
+  if (recording) return false;
+
+  char name[32];
+  uint16_t i;
+  for (i = 0; i < 1000; i++) {
+    snprintf(name, sizeof(name), "/session_%03u.bin", i);
+    if (!SD.exists(name)) break;
+  }
+  if (i == 1000) {
+    VLF("MSG: SdWriter, all session file names used");
+    return false;
+  }
+  recFile = SD.sdfs.open(name, O_WRONLY | O_CREAT | O_TRUNC);
+  if (!recFile) {
+    VLF("MSG: SdWriter, can't create session file");
+    return false;
+  }
+  // contiguous space so that every write is sequential, without it the
+  // recording still works but the card allocates clusters as it goes
+  if (!recFile.preAllocate(REC_FILE_BYTES)) VLF("MSG: SdWriter, no contiguous space for the session");
+
+  head = tail = count = 0;
+  queued = written = 0;
+  dropped = 0;
+  gap = true; // starts with a keyframe
+  backedUp = false;
+  stopping = false;
+  recording = true;
+  recStartMs = millis();
+  lastSyncMs = recStartMs;
+
+  uint8_t header[REC_FILE_HEADER] = { 'D', 'D', 'S', 'R', 1, 0,
+    SCREEN_WIDTH & 0xFF, SCREEN_WIDTH >> 8, SCREEN_HEIGHT & 0xFF, SCREEN_HEIGHT >> 8 };
+  ringPut(header, sizeof(header));
+  VF("MSG: SdWriter, recording to "); VLF(name);
+  return true;
+}
+
+void SdWriter::stopRecording() {
+  if (recording) stopping = true;
+}
+
+void SdWriter::ringPut(const uint8_t* data, uint32_t len) {
+  uint32_t first = min(len, REC_RING_SIZE - head);
+  memcpy(recRing + head, data, first);
+  memcpy(recRing, data + first, len - first);
+  head = (head + len) % REC_RING_SIZE;
+  count += len;
+  queued += len;
+}
+
+bool SdWriter::recordFrame(uint8_t codec, bool delta, const uint8_t* data, uint32_t len) {
+  if (!recording || stopping) return true;
+  uint32_t size = REC_FRAME_HEADER + len;
+  if (queued + size > REC_FILE_BYTES) {
+    VLF("MSG: SdWriter, session file full");
+    stopping = true;
+    return true;
+  }
+  if (count + size > REC_RING_SIZE) backedUp = true;
+  if ((delta && gap) || isBackedUp()) {
+    // a delta is useless without the frame before it
+    if (!gap) dropped++;
+    gap = true;
+    return false;
+  }
+  gap = false;
+
+  uint32_t ms = millis() - recStartMs;
+  uint8_t header[REC_FRAME_HEADER] = { (uint8_t)ms, (uint8_t)(ms >> 8), (uint8_t)(ms >> 16), (uint8_t)(ms >> 24), codec,
+    (uint8_t)len, (uint8_t)(len >> 8), (uint8_t)(len >> 16), (uint8_t)(len >> 24) };
+  ringPut(header, sizeof(header));
+  ringPut(data, len);
+  return true;
+}
+
+// Backed up until the ring has room for a frame of any size again
+bool SdWriter::isBackedUp() {
+  if (backedUp && count + REC_FRAME_HEADER + UNCOMPRESSED_BUFFER_SIZE <= REC_RING_SIZE) backedUp = false;
+  return recording && !stopping && backedUp;
+}
+
+// One chunk from the ring per tick. Chunks end on a 512 byte sector of the
+// file, so the card never has to read back a partial sector, except for the
+// tail that goes out when the file size is synced and when stopping. The
+// ring is a whole number of sectors, so its end is a sector end of the file too.
+void SdWriter::writeRecording() {
+  bool sync = millis() - lastSyncMs >= REC_SYNC_MS;
+  uint32_t n = min(count, REC_RING_SIZE - tail);
+  n = min(n, (uint32_t)SD_WRITE_CHUNK - written % 512);
+  if (!sync && !stopping) n -= (written + n) % 512;
+
+  if (n) {
+    if (recFile.write(recRing + tail, n) != n) {
+      VLF("MSG: SdWriter, session write failed");
+      recFile.close();
+      recording = stopping = false;
+      return;
+    }
+    tail = (tail + n) % REC_RING_SIZE;
+    count -= n;
+    written += n;
+  }
+
+  if (stopping && count == 0) {
+    recFile.truncate(written); // give back the preallocated space not used
+    recFile.close();
+    recording = stopping = false;
+    VF("MSG: SdWriter, session closed, KB "); VL(written / 1024);
+    if (dropped) { VF("MSG: SdWriter, frames dropped "); VL(dropped); }
+  } else if (sync && count < 512) {
+    recFile.flush(); // directory entry gets the size, a power cut loses at most this interval
+    lastSyncMs = millis();
+  }
+}
+
+// ==================== Screen Capture ====================
+bool SdWriter::saveScreen(const char* fileName, const uint8_t* frame, uint32_t len) {
+  if (capPending || len > sizeof(capBuffer)) return false;
+  memcpy(capBuffer, frame, len);
+  strlcpy(capName, fileName, sizeof(capName));
+  capSize = len;
+  capPos = 0;
+  capPending = true;
+  return true;
+}
+
+// Next chunk of the screen capture, false when there is none
+bool SdWriter::writeCapture() {
+  if (!capPending) return false;
+  if (!capFile) {
+    capFile = SD.sdfs.open(capName, O_WRONLY | O_CREAT | O_TRUNC);
+    if (!capFile) {
+      SERIAL_DEBUG.print("Failed to open file for writing: ");
+      SERIAL_DEBUG.println(capName);
+      capPending = false;
+      return true;
+    }
+    capFile.preAllocate(capSize);
+  }
+
+  uint32_t n = min(capSize - capPos, (uint32_t)SD_WRITE_CHUNK);
+  if (capFile.write(capBuffer + capPos, n) != n) {
+    SERIAL_DEBUG.print("Write failed: ");
+    SERIAL_DEBUG.println(capName);
+    capFile.close();
+    capPending = false;
+    return true;
+  }
+  capPos += n;
+  if (capPos == capSize) {
+    capFile.close();
+    capPending = false;
+    SERIAL_DEBUG.print("Buffer saved to SD card as: ");
+    SERIAL_DEBUG.println(capName);
+  }
+  return true;
+}
+
+// A capture is a single screen, it goes first; the recording ring can wait a few ticks
+void SdWriter::poll() {
+  if (writeCapture()) return;
+  if (recording) writeRecording();
+}
+
+SdWriter sdWriter;
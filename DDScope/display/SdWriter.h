@@ -0,0 +1,80 @@
+// =====================================================
+// SdWriter.h
+// Background SD card writer for screen captures and session recordings
+//
+// A write to the SD card can take several milliseconds, too long for the
+// screen and touch tasks. Callers hand the data over to PSRAM and return, and
+// the sdWriter task puts a few KB per tick on the card. Files get their space
+// preallocated contiguously up front, so the card sees long sequential writes
+// without FAT cluster allocation in between.
+//
+// A session recording is every mirror frame as it was compressed for the
+// ESP32-S3, keyframes and deltas, with a timestamp (see WifiHandController.md).
+
+#ifndef SD_WRITER_H
+#define SD_WRITER_H
+
+#include <Arduino.h>
+#include <SD.h>
+
+#define SD_WRITE_CHUNK       8192                // bytes per task tick, multiple of 512
+#define REC_RING_SIZE        (1024*1024)         // PSRAM between the mirror and the card
+#define REC_FILE_BYTES       (256UL*1024*1024)   // space preallocated for a session
+#define REC_SYNC_MS          5000                // the file size on the card is brought up to date this often
+#define REC_FILE_HEADER      16                  // "DDSR", version, width, height, reserved
+#define REC_FRAME_HEADER     9                   // time ms u32, codec u8, length u32
+
+class SdWriter {
+  public:
+    // Session recording to the next free /session_NNN.bin, false if there
+    // is none. Stopping finishes in the background, the file is cut to what
+    // was written.
+    bool startRecording();
+    void stopRecording();
+    bool isRecording() { return recording && !stopping; }
+
+    // Copy a compressed mirror frame into the ring. Returns false if it was
+    // dropped (ring full, file full); deltas are then dropped as well until
+    // the next keyframe, which the caller should send soon.
+    bool recordFrame(uint8_t codec, bool delta, const uint8_t* data, uint32_t len);
+    // The ring turned a frame away and isn't down to room for a full frame
+    // yet. Frames taken meanwhile are dropped, so the caller should hold back
+    // and send the keyframe once this is over.
+    bool isBackedUp();
+
+    // Write len bytes of frame to fileName in the background, replacing the
+    // file. False while the previous capture is still being written.
+    bool saveScreen(const char* fileName, const uint8_t* frame, uint32_t len);
+
+    // sdWriter task
+    void poll();
+
+  private:
+    bool writeCapture();
+    void writeRecording();
+    void ringPut(const uint8_t* data, uint32_t len);
+
+    // screen capture being written
+    FsFile   capFile;
+    char     capName[64];
+    uint32_t capSize = 0;
+    uint32_t capPos = 0;
+    bool     capPending = false;
+
+    // session recording
+    FsFile   recFile;
+    bool     recording = false;
+    bool     stopping = false;
+    bool     gap = false;            // a frame was dropped, wait for a keyframe
+    bool     backedUp = false;       // see isBackedUp()
+    uint32_t recStartMs = 0;
+    uint32_t queued = 0;             // bytes handed to the ring since the start
+    uint32_t written = 0;            // bytes on the card
+    uint32_t head = 0, tail = 0, count = 0;
+    unsigned long lastSyncMs = 0;
+    uint32_t dropped = 0;
+};
+
+extern SdWriter sdWriter;
+
+#endif
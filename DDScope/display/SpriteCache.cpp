@@ -0,0 +1,52 @@
+// =====================================================
+// SpriteCache.cpp
+//
+// Pre-rendered RGB565 button images in PSRAM
+
+#include "Display.h"
+#include "SpriteCache.h"
+
+EXTMEM static uint16_t spritePool[SPRITE_POOL_PIXELS];
+
+static bool sameKey(const SpriteKey& a, const SpriteKey& b) {
+  return a.w == b.w && a.h == b.h && a.textX == b.textX && a.textY == b.textY &&
+         a.labelHash == b.labelHash && a.font == b.font && a.fill == b.fill &&
+         a.border == b.border && a.text == b.text && a.page == b.page;
+}
+
+// FNV-1a of the label
+uint32_t SpriteCache::hash(const char* text) {
+  uint32_t h = 2166136261UL;
+  for (const char* p = text; *p; p++) h = (h ^ (uint8_t)*p)*16777619UL;
+  return h;
+}
+
+const uint16_t* SpriteCache::find(const SpriteKey& key) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (sameKey(entries[i].key, key)) return spritePool + entries[i].offset;
+  }
+  return NULL;
+}
+
+// Bump allocation from the pool; a screen only uses a few dozen sprites so
+// rather than evicting one by one, everything is dropped when it runs out
+uint16_t* SpriteCache::add(const SpriteKey& key) {
+  uint32_t pixels = (uint32_t)key.w*key.h;
+  if (pixels == 0 || pixels > SPRITE_POOL_PIXELS) return NULL;
+
+  if (count >= SPRITE_CACHE_ENTRIES || used + pixels > SPRITE_POOL_PIXELS) {
+    VLF("MSG: SpriteCache, pool full, starting over");
+    invalidate();
+  }
+  entries[count].key    = key;
+  entries[count].offset = used;
+  used += pixels;
+  return spritePool + entries[count++].offset;
+}
+
+void SpriteCache::invalidate() {
+  count = 0;
+  used  = 0;
+}
+
+SpriteCache spriteCache;
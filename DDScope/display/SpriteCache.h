@@ -0,0 +1,59 @@
+// =====================================================
+// SpriteCache.h
+// Pre-rendered RGB565 button images in PSRAM
+//
+// Buttons are drawn as a rounded fill, a rounded outline and a label, which
+// is hundreds of small address windows on the ILI9486. The cache keeps the
+// finished image of every button look it has seen, keyed by size, label,
+// font and colors, so drawing a button again is one writeRect() blit.
+
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+#define SPRITE_POOL_PIXELS   (320*480) // 300KB of PSRAM shared by all sprites
+#define SPRITE_CACHE_ENTRIES       96  // menu bars and buttons of a few screens, both states
+
+typedef struct SpriteKey {
+  uint16_t        w;
+  uint16_t        h;
+  int16_t         textX;     // label cursor inside the sprite
+  int16_t         textY;
+  uint32_t        labelHash;
+  const GFXfont*  font;
+  uint16_t        fill;
+  uint16_t        border;
+  uint16_t        text;
+  uint16_t        page;      // surface under the button, shows in the rounded corners
+} SpriteKey;
+
+class SpriteCache {
+  public:
+    // Pixels of the sprite for key, NULL if it isn't cached
+    const uint16_t* find(const SpriteKey& key);
+
+    // Room for a new sprite of key.w x key.h that the caller renders into, NULL if
+    // it can never fit. When the pool is full the cache starts over empty.
+    uint16_t* add(const SpriteKey& key);
+
+    // Drop all sprites, used when the color theme changes
+    void invalidate();
+
+    static uint32_t hash(const char* text);
+
+  private:
+    struct Entry {
+      SpriteKey key;
+      uint32_t  offset;      // into the pixel pool
+    };
+
+    Entry     entries[SPRITE_CACHE_ENTRIES];
+    uint8_t   count = 0;
+    uint32_t  used  = 0;
+};
+
+extern SpriteCache spriteCache;
+
+#endif
@@ -0,0 +1,102 @@
+// =====================================================
+// UILayout.cpp
+//
+// Table driven screen layouts, shared by drawing and touch hit-testing
+
+#include "Display.h"
+#include "UILayout.h"
+#include "SpriteCache.h"
+
+// UILayout constructor
+UILayout::UILayout(const UIElement* elements, uint8_t count, const UIStyle* styles) {
+  l_elements = elements;
+  l_styles   = styles;
+  l_count    = (count > UI_MAX_ELEMENTS) ? UI_MAX_ELEMENTS : count;
+  invalidateAll();
+}
+
+// Bucket the buttons into a coarse grid, each cell holds a bit for every
+// button that overlaps it so a touch only has to check those few rectangles
+void UILayout::buildGrid() {
+  memset(l_grid, 0, sizeof(l_grid));
+  for (uint8_t i = 0; i < l_count; i++) {
+    const UIElement* e = &l_elements[i];
+    if (e->id != i) { VF("MSG: UILayout, element out of order, id="); VL(e->id); }
+    if (e->type != UI_BUTTON) continue;
+
+    int16_t c0 = e->x/UI_GRID_CELL,           c1 = (e->x + e->w)/UI_GRID_CELL;
+    int16_t r0 = e->y/UI_GRID_CELL,           r1 = (e->y + e->h)/UI_GRID_CELL;
+    if (c0 < 0) c0 = 0; if (c1 >= UI_GRID_COLS) c1 = UI_GRID_COLS - 1;
+    if (r0 < 0) r0 = 0; if (r1 >= UI_GRID_ROWS) r1 = UI_GRID_ROWS - 1;
+    for (int16_t r = r0; r <= r1; r++)
+      for (int16_t c = c0; c <= c1; c++) l_grid[r*UI_GRID_COLS + c] |= (1UL << i);
+  }
+  l_gridValid = true;
+}
+
+// Find the button under a touch, the edges themselves don't count as a hit
+uint8_t UILayout::hitTest(uint16_t px, uint16_t py) {
+  if (!l_gridValid) buildGrid();
+  if (px >= UI_GRID_COLS*UI_GRID_CELL || py >= UI_GRID_ROWS*UI_GRID_CELL) return UI_NONE;
+
+  uint32_t candidates = l_grid[(py/UI_GRID_CELL)*UI_GRID_COLS + px/UI_GRID_CELL];
+  while (candidates) {
+    uint8_t i = __builtin_ctz(candidates);
+    candidates &= candidates - 1;
+    const UIElement* e = &l_elements[i];
+    if (px > e->x && px < e->x + e->w && py > e->y && py < e->y + e->h) return e->id;
+  }
+  return UI_NONE;
+}
+
+// True if the element shows something else than (text, state) or the screen was redrawn since
+bool UILayout::changed(uint8_t id, const char* text, bool state) {
+  uint32_t hash = SpriteCache::hash(text);
+  uint32_t generation = ValueWidget::currentGeneration();
+  if (l_generation[id] == generation && l_hash[id] == hash && l_state[id] == state) return false;
+  l_generation[id] = generation;
+  l_hash[id]       = hash;
+  l_state[id]      = state;
+  return true;
+}
+
+void UILayout::drawButton(uint8_t id, bool active) {
+  if (id >= l_count) return;
+  const UIElement* e = &l_elements[id];
+  drawButton(id, (active && e->labelOn != NULL) ? e->labelOn : e->label, active);
+}
+
+void UILayout::drawButton(uint8_t id, const char* label, bool active) {
+  if (id >= l_count || !changed(id, label, active)) return;
+  const UIElement* e = &l_elements[id];
+  const UIStyle* s = &l_styles[e->style];
+
+  const GFXfont* font = tft.getFont();
+  tft.setFont(s->font);
+  s->button->draw(e->x, e->y, e->w, e->h, label, active);
+  tft.setFont(font);
+}
+
+void UILayout::drawLabels() {
+  for (uint8_t i = 0; i < l_count; i++) {
+    const UIElement* e = &l_elements[i];
+    if (e->type != UI_LABEL || !changed(i, e->label, false)) continue;
+    l_styles[e->style].canvas->printLJ(e->x, e->y, e->w, e->h, e->label, false);
+  }
+}
+
+void UILayout::drawValue(uint8_t id, const char* text, bool warning, bool leftJustify) {
+  if (id >= l_count || !changed(id, text, warning)) return;
+  const UIElement* e = &l_elements[id];
+  CanvasPrint* canvas = l_styles[e->style].canvas;
+  if (leftJustify) canvas->printLJ(e->x, e->y, e->w, e->h, text, warning);
+  else             canvas->printRJ(e->x, e->y, e->w, e->h, text, warning);
+}
+
+void UILayout::invalidate(uint8_t id) {
+  if (id < UI_MAX_ELEMENTS) l_generation[id] = 0;
+}
+
+void UILayout::invalidateAll() {
+  for (uint8_t i = 0; i < UI_MAX_ELEMENTS; i++) l_generation[i] = 0;
+}
@@ -0,0 +1,91 @@
+// =====================================================
+// UILayout.h
+// Table driven screen layouts
+//
+// A screen describes its buttons, labels and value fields once, as a table of
+// UIElement rows. The same table is used to draw the elements and to find the
+// element under a touch, so geometry lives in one place. Each element remembers
+// what it last drew and is only redrawn when its label, state or value changes.
+
+#ifndef UI_LAYOUT_H
+#define UI_LAYOUT_H
+
+#include <Arduino.h>
+#include <gfxfont.h>
+
+#define UI_GRID_CELL        40  // hit-test bucket size in pixels
+#define UI_GRID_COLS        (320/UI_GRID_CELL)
+#define UI_GRID_ROWS        (480/UI_GRID_CELL)
+#define UI_MAX_ELEMENTS     32  // one bit per element in each grid cell
+#define UI_NONE           0xFF  // hitTest() result when no button was touched
+
+class Button;
+class CanvasPrint;
+
+typedef enum {
+  UI_BUTTON,  // touchable, drawn with the style's Button
+  UI_LABEL,   // static text, drawn once per screen draw with the style's CanvasPrint
+  UI_VALUE,   // text updated at run time with the style's CanvasPrint
+} UIElementType;
+
+// How a group of elements is rendered
+typedef struct UIStyle {
+  Button*         button;
+  const GFXfont*  font;    // font selected while drawing a button label
+  CanvasPrint*    canvas;
+} UIStyle;
+
+// One row of a screen layout table, the row index must equal id
+typedef struct UIElement {
+  uint8_t         id;
+  UIElementType   type;
+  uint8_t         style;   // index into the layout's style table
+  int16_t         x;
+  int16_t         y;
+  uint16_t        w;
+  uint16_t        h;
+  const char*     label;   // button label when off, or the label text
+  const char*     labelOn; // button label when on, NULL to use label
+} UIElement;
+
+class UILayout {
+  public:
+    // constructor
+    UILayout(const UIElement* elements, uint8_t count, const UIStyle* styles);
+
+    // id of the button whose rectangle contains the point, UI_NONE if none
+    uint8_t hitTest(uint16_t px, uint16_t py);
+
+    // Draw a button with the label from its table row, or with the given label
+    void drawButton(uint8_t id, bool active);
+    void drawButton(uint8_t id, const char* label, bool active);
+
+    // Draw every UI_LABEL element
+    void drawLabels();
+
+    // Print a UI_VALUE element, right justified unless leftJustify
+    void drawValue(uint8_t id, const char* text, bool warning, bool leftJustify = false);
+
+    // Force the element(s) to be drawn on the next call
+    void invalidate(uint8_t id);
+    void invalidateAll();
+
+    const UIElement* element(uint8_t id) { return (id < l_count) ? &l_elements[id] : NULL; }
+
+  private:
+    void buildGrid();
+    bool changed(uint8_t id, const char* text, bool state);
+
+    const UIElement* l_elements;
+    const UIStyle*   l_styles;
+    uint8_t          l_count;
+    bool             l_gridValid = false;
+    uint32_t         l_grid[UI_GRID_COLS*UI_GRID_ROWS];
+
+    // what each element last drew
+    uint32_t         l_generation[UI_MAX_ELEMENTS];
+    uint32_t         l_hash[UI_MAX_ELEMENTS];
+    bool             l_state[UI_MAX_ELEMENTS];
+};
+
+#endif
@@ -6,9 +6,43 @@
 
 #include "Display.h"
 #include "UIelements.h"
+#include "GlyphCache.h"
+#include "SpriteCache.h"
+#include "DrawRecorder.h"
 #include "Adafruit_GFX.h"
 #include "../fonts/Inconsolata_Bold8pt7b.h"
 
+// Minimal GFX target over an RGB565 buffer, used to pre-render button sprites
+// and for CanvasPrint fields in the default (classic) font
+class BufferCanvas : public Adafruit_GFX {
+  public:
+    BufferCanvas() : Adafruit_GFX(TFTWIDTH, TFTHEIGHT) {}
+    void begin(uint16_t* buffer, uint16_t w, uint16_t h, uint16_t bg) {
+      _buffer = buffer; _width = w; _height = h;
+      for (uint32_t i = 0; i < (uint32_t)w*h; i++) _buffer[i] = bg;
+    }
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+      if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+      _buffer[y*_width + x] = color;
+    }
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+      if (x < 0) { w += x; x = 0; }
+      if (y < 0) { h += y; y = 0; }
+      if (x + w > _width)  w = _width - x;
+      if (y + h > _height) h = _height - y;
+      for (int16_t r = 0; r < h; r++) {
+        uint16_t* p = _buffer + (y + r)*_width + x;
+        for (int16_t c = 0; c < w; c++) p[c] = color;
+      }
+    }
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+
+  private:
+    uint16_t* _buffer = NULL;
+};
+static BufferCanvas bufferCanvas;
+
 // =======================================================================
 // ======================= Button UI elements ============================
 // =======================================================================
@@ -18,12 +52,13 @@ Button::Button(
       int           y,
       uint16_t      width,
       uint16_t      height,
-      uint16_t      colorActive,
-      uint16_t      colorNotActive,
-      uint16_t      colorBorder,
+      const uint16_t* colorActive,
+      const uint16_t* colorNotActive,
+      const uint16_t* colorBorder,
       uint8_t       fontCharWidth,
       uint8_t       fontCharHeight,
-      const char*   label)
+      const char*   label,
+      const uint16_t* colorBehind)
   {                
     b_x               = x;
     b_y               = y;
@@ -32,11 +67,70 @@ Button::Button(
     b_colorActive     = colorActive;
     b_colorNotActive  = colorNotActive;
     b_colorBorder     = colorBorder;
+    b_colorBehind     = colorBehind ? colorBehind : &pgBackground;
     b_fontCharWidth   = fontCharWidth;
     b_fontCharHeight  = fontCharHeight;      
     b_label           = label;
   }
 
+// Print a button label at the cursor position. The label sits on the solid button
+// fill, so when its text box fits inside the border, clear of the rounded corners,
+// it is blitted from the glyph cache
+static void printLabel(int x, int y, uint16_t width, uint16_t height,
+                       int16_t cx, int16_t cy, const char* label, uint16_t fill) {
+  uint16_t w; int16_t top, bottom;
+  if (glyphCache.textBounds(label, tft.getFont(), &w, &top, &bottom) &&
+      cx >= x + BUTTON_RADIUS && cx + w <= x + width - BUTTON_RADIUS &&
+      cy + top > y && cy + bottom < y + height - 1) {
+    if (glyphCache.drawText(cx, cy, label, tft.getFont(), tft.getTextColor(), fill)) return;
+  }
+  tft.setCursor(cx, cy);
+  tft.print(label);
+}
+
+// Blit a button from its sprite, rendering the sprite first if this look of the
+// button hasn't been seen yet. The sprite is a full rectangle, so the corners
+// outside the rounded border are filled with behind, the color under the button.
+// Returns false if it has to be drawn directly.
+static bool drawSprite(int x, int y, uint16_t width, uint16_t height, int16_t textX, int16_t textY,
+                       const char* label, uint16_t fill, uint16_t border, uint16_t behind) {
+  if (x < 0 || y < 0 || x + width > tft.width() || y + height > tft.height()) return false;
+
+  SpriteKey key = { width, height, textX, textY, SpriteCache::hash(label), tft.getFont(),
+                    fill, border, tft.getTextColor(), behind };
+  const uint16_t* pixels = spriteCache.find(key);
+  if (pixels == NULL) {
+    uint16_t* sprite = spriteCache.add(key);
+    if (sprite == NULL) return false;
+    bufferCanvas.begin(sprite, width, height, behind);
+    bufferCanvas.fillRoundRect(0, 0, width, height, BUTTON_RADIUS, fill);
+    bufferCanvas.drawRoundRect(0, 0, width, height, BUTTON_RADIUS, border);
+    bufferCanvas.setFont(key.font);
+    bufferCanvas.setTextColor(key.text);
+    bufferCanvas.setTextWrap(false);
+    bufferCanvas.setCursor(textX, textY);
+    bufferCanvas.print(label);
+    pixels = sprite;
+  }
+#ifdef ENABLE_TFT_DRAWCMDS
+  // the mirror gets the calls the sprite was rendered with
+  drawRecorder.pause();
+  bool drawn = tft.writeRect(x, y, width, height, pixels);
+  drawRecorder.resume();
+  if (drawn) {
+    drawRecorder.fill(x, y, width, height, key.page);
+    drawRecorder.roundRect(x, y, width, height, BUTTON_RADIUS, fill, true);
+    drawRecorder.roundRect(x, y, width, height, BUTTON_RADIUS, border, false);
+    drawRecorder.clip(x, y, width, height);
+    drawRecorder.text(x + textX, y + textY, key.font, 1, key.text, key.text, label, strlen(label), -1);
+    drawRecorder.clip(0, 0, 0, 0);
+  }
+  return drawn;
+#else
+  return tft.writeRect(x, y, width, height, pixels);
+#endif
+}
+
 // =====================================================================
 // Draw Button, Center Text, Custom Font
 // Draw a single button, assume constructor called to set colors and font size
@@ -54,14 +148,12 @@ void Button::draw(int x, int y, uint16_t width, uint16_t height, const char* lab
   // Adafruit_GFX::setFont(const GFXfont *f) does an offset of +/- 6 pixels based on default vs. custom font.
   // Hence, that is why this calculation looks weird, standards would be nice :-/
   uint16_t yTextOffset = ((height - b_fontCharHeight)/2) + b_fontCharHeight-4;
-  if (active) { // show active background
-    tft.fillRoundRect(x, y, width, height, buttonRadius, b_colorActive);
-  } else {
-    tft.fillRoundRect(x, y, width, height, buttonRadius, b_colorNotActive);
-  }
-  tft.drawRoundRect(x, y, width, height, buttonRadius, b_colorBorder);
-  tft.setCursor(x+xTextOffset, y+yTextOffset);
-  tft.print(label);
+  uint16_t fill = active ? *b_colorActive : *b_colorNotActive;
+  if (drawSprite(x, y, width, height, xTextOffset, yTextOffset, label, fill, *b_colorBorder, *b_colorBehind)) return;
+
+  tft.fillRoundRect(x, y, width, height, buttonRadius, fill);
+  tft.drawRoundRect(x, y, width, height, buttonRadius, *b_colorBorder);
+  printLabel(x, y, width, height, x+xTextOffset, y+yTextOffset, label, fill);
 }
 
 // Draw a single button, overload, no font changes from constructor
@@ -81,104 +173,213 @@ void Button::draw(int y, const char* label, bool active) {
 void Button::drawLJ(int x, int y, uint16_t width, uint16_t height, const char* label, bool active) {
   int buttonRadius = BUTTON_RADIUS;
   uint16_t yTextOffset = ((height - b_fontCharHeight)/2) + b_fontCharHeight-6;
-  if (active) { // show active background
-    tft.fillRoundRect(x, y, width, height, buttonRadius, b_colorActive);
-  } else {
-    tft.fillRoundRect(x, y, width, height, buttonRadius, b_colorNotActive);
-  }
-  tft.drawRoundRect(x, y, width, height, buttonRadius, b_colorBorder);
-  tft.setCursor(x+2, y+yTextOffset);
-  tft.print(label);
+  uint16_t fill = active ? *b_colorActive : *b_colorNotActive;
+  if (drawSprite(x, y, width, height, 2, yTextOffset, label, fill, *b_colorBorder, *b_colorBehind)) return;
+
+  tft.fillRoundRect(x, y, width, height, buttonRadius, fill);
+  tft.drawRoundRect(x, y, width, height, buttonRadius, *b_colorBorder);
+  printLabel(x, y, width, height, x+2, y+yTextOffset, label, fill);
 }
 
 // =======================================================================
 // ================= Canvas print UI elements ============================
 // =======================================================================
+// All CanvasPrint fields are rendered into one RGB565 arena that is reused for
+// every call, no canvas is allocated and freed per field. Largest field in use
+// is the full width error/status line (317 x 16).
+DMAMEM static uint16_t canvasArena[CANVAS_ARENA_PIXELS];
+
 // Canvas Print constructor
 CanvasPrint::CanvasPrint(const GFXfont *font) { c_font = (GFXfont *)font; }
 
+// Pad or copy text into dst, right justified to minWidth like "%9s" or left like "%-9s"
+static void padText(char* dst, const char* src, uint8_t minWidth, bool leftJustify) {
+  size_t len = strlen(src);
+  if (len > CANVAS_TEXT_MAX) len = CANVAS_TEXT_MAX;
+  size_t pad = (len < minWidth) ? minWidth - len : 0;
+  char* p = dst;
+  if (!leftJustify) { memset(p, ' ', pad); p += pad; }
+  memcpy(p, src, len); p += len;
+  if (leftJustify) { memset(p, ' ', pad); p += pad; }
+  *p = 0;
+}
+
+// Integer to text, replaces sprintf("%d")
+static void formatInt(char* dst, long value) {
+  char tmp[12];
+  uint8_t n = 0;
+  bool neg = value < 0;
+  unsigned long v = neg ? 0UL - (unsigned long)value : value; // LONG_MIN has no positive long
+  do { tmp[n++] = '0' + v % 10; v /= 10; } while (v);
+  if (neg) *dst++ = '-';
+  while (n) *dst++ = tmp[--n];
+  *dst = 0;
+}
+
+// One decimal fixed point right justified to 6 characters, replaces sprintf("%6.1f")
+void CanvasPrint::formatFixed1(char* dst, double value) {
+  if (isnan(value) || isinf(value)) { padText(dst, "nan", 6, false); return; }
+  // sign from the value, not the rounded tenths, so -0.04 stays "-0.0" like dtostrf()
+  long tenths = lround(fabs(value) * 10.0);
+  char tmp[16];
+  char* p = tmp;
+  if (signbit(value)) *p++ = '-';
+  formatInt(p, tenths / 10);
+  p += strlen(p);
+  *p++ = '.';
+  *p++ = '0' + tenths % 10;
+  *p = 0;
+  padText(dst, tmp, 6, false);
+}
+
 // ===================== Canvas Print ==============================
-// Right Justified, vertically centered
-void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
-  char ch_label[80] = "";
+// Render text into the arena at the canvas cursor position and blit the box in one window
+void CanvasPrint::render(int x, int y, uint16_t width, uint16_t height, const char* text, bool warning) {
   int y_box_offset;
   if (c_font == NULL) {
     y_box_offset = -6; // default font offset
   } else {
     y_box_offset = 10; // custom font offset
   }
-  GFXcanvas1 canvas(width, height); // creates buffer
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%9s", c_label);
-  canvas.print(ch_label); // print to buffer
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
+  if (width > TFTWIDTH) width = TFTWIDTH;
+  if ((uint32_t)width*height > CANVAS_ARENA_PIXELS) height = CANVAS_ARENA_PIXELS/width;
+  uint16_t bg = warning ? butOnBackground : butBackground; // show warning background
+  int16_t cursorY = (height-y_box_offset)/2 + y_box_offset; // offset from top left corner of canvas box
+
+  if (!glyphCache.compose(canvasArena, width, height, 0, cursorY, text, c_font, textColor, bg)) {
+    bufferCanvas.begin(canvasArena, width, height, bg);
+    bufferCanvas.setFont(c_font);
+    bufferCanvas.setTextColor(textColor);
+    bufferCanvas.setTextWrap(false);
+    bufferCanvas.setCursor(0, cursorY);
+    bufferCanvas.print(text);
+  }
+#ifdef ENABLE_TFT_DRAWCMDS
+  // the mirror gets the box and the text, clipped to the box like the arena
+  drawRecorder.pause();
+  bool drawn = tft.writeRect(x, y - y_box_offset, width, height, canvasArena);
+  drawRecorder.resume();
+  if (drawn) {
+    drawRecorder.fill(x, y - y_box_offset, width, height, bg);
+    drawRecorder.clip(x, y - y_box_offset, width, height);
+    drawRecorder.text(x, y - y_box_offset + cursorY, c_font, 1, textColor, textColor, text, strlen(text), -1);
+    drawRecorder.clip(0, 0, 0, 0);
   }
+#else
+  tft.writeRect(x, y - y_box_offset, width, height, canvasArena);
+#endif
+}
+
+// Right Justified, vertically centered
+void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
+  char ch_label[CANVAS_TEXT_MAX + 1];
+  padText(ch_label, c_label, 9, false);
+  render(x, y, width, height, ch_label, warning);
 }
 
 // Left Justified, vertically centered
 void CanvasPrint::printLJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning) {
-  char ch_label[80] = "";
-  int y_box_offset;
-  if (c_font == NULL) {
-    y_box_offset = -6; // default font offset
-  } else {
-    y_box_offset = 10; // custom font offset
-  }
-  GFXcanvas1 canvas(width, height);
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%-9s", c_label);
-  canvas.print(ch_label);
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
-  }
+  char ch_label[CANVAS_TEXT_MAX + 1];
+  padText(ch_label, c_label, 9, true);
+  render(x, y, width, height, ch_label, warning);
 }
 
 // Right Justified Overload for double
 void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, double label, bool warning) {
-  char ch_label[80] = "";
-  int y_box_offset;
-  if (c_font == NULL) {
-    y_box_offset = -6; // default font offset
-  } else {
-    y_box_offset = 10; // custom font offset
-  }
-  GFXcanvas1 canvas(width, height);
-  canvas.setFont(c_font); 
-  canvas.setCursor(0, (height-y_box_offset)/2 + y_box_offset); // offset from top left corner of canvas box
-  sprintf(ch_label, "%6.1f", label);
-  canvas.print(ch_label);
-  if (warning) { // show warning background
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butOnBackground);
-  } else {
-    tft.drawBitmap(x, y - y_box_offset, canvas.getBuffer(), width, height, textColor, butBackground);
-  }
-}
-/*
-// Right Justified Overload for double 
-// ***Not sure why this doesn't work. Truncates digits after decimal. Using the one above instead. 
-void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, double d_label, bool warning) {
-  char c_label[7]="";
-  sprintf(c_label, "%6.1f", d_label);
-  printRJ(x, y, width, height, c_label, warning);
+  char ch_label[CANVAS_TEXT_MAX + 1];
+  formatFixed1(ch_label, label);
+  render(x, y, width, height, ch_label, warning);
 }
-*/
+
 // Right JustifiedOverload for int
 void CanvasPrint::printRJ(int x, int y, uint16_t width, uint16_t height, int i_label, bool warning) {
-  char ch_label[7]="";
-  sprintf(ch_label, "%d", i_label);
+  char ch_label[12];
+  formatInt(ch_label, i_label);
   printRJ(x, y, width, height, ch_label, warning);
  }
 
 // Left Justified Overload for int
 void CanvasPrint::printLJ(int x, int y, uint16_t width, uint16_t height, int i_label, bool warning) {
-  char ch_label[7]="";
-  sprintf(ch_label, "%-d", i_label);
+  char ch_label[12];
+  formatInt(ch_label, i_label);
   printLJ(x, y, width, height, ch_label, warning);
  }
+
+// =======================================================================
+// ================= Retained widget UI elements =========================
+// =======================================================================
+uint32_t ValueWidget::screenGeneration = 1;
+
+// Value Widget constructor
+ValueWidget::ValueWidget(CanvasPrint* canvas, int x, int y, uint16_t width, uint16_t height, bool rightJustify) {
+  w_canvas       = canvas;
+  w_x            = x;
+  w_y            = y;
+  w_width        = width;
+  w_height       = height;
+  w_rightJustify = rightJustify;
+}
+
+// True when the field on screen no longer shows this text in these colors; remembers the new state
+bool ValueWidget::changed(const char* text, bool warning) {
+  uint16_t bg = warning ? butOnBackground : butBackground;
+  if (w_valid && w_generation == screenGeneration && w_warning == warning &&
+      w_fg == textColor && w_bg == bg && strncmp(w_last, text, CANVAS_TEXT_MAX) == 0) return false;
+
+  strncpy(w_last, text, CANVAS_TEXT_MAX);
+  w_last[CANVAS_TEXT_MAX] = 0;
+  w_warning    = warning;
+  w_fg         = textColor;
+  w_bg         = bg;
+  w_generation = screenGeneration;
+  w_valid      = true;
+  return true;
+}
+
+void ValueWidget::set(const char* text, bool warning) {
+  if (!changed(text, warning)) return;
+  if (w_rightJustify) {
+    w_canvas->printRJ(w_x, w_y, w_width, w_height, text, warning);
+  } else {
+    w_canvas->printLJ(w_x, w_y, w_width, w_height, text, warning);
+  }
+}
+
+// compare on the formatted text so that changes below display resolution don't redraw
+void ValueWidget::set(double value, bool warning) {
+  char text[CANVAS_TEXT_MAX + 1];
+  CanvasPrint::formatFixed1(text, value);
+  if (!changed(text, warning)) return;
+  w_canvas->printRJ(w_x, w_y, w_width, w_height, value, warning);
+}
+
+// Label Widget constructor
+LabelWidget::LabelWidget(const GFXfont *font, int x, int y, uint16_t width, uint16_t height, int16_t textX, int16_t textY) {
+  l_font   = font;
+  l_x      = x;
+  l_y      = y;
+  l_width  = width;
+  l_height = height;
+  l_textX  = textX;
+  l_textY  = textY;
+}
+
+void LabelWidget::set(const char* text, uint16_t background) {
+  if (l_valid && l_generation == ValueWidget::currentGeneration() && l_fg == textColor &&
+      l_bg == background && strncmp(l_last, text, CANVAS_TEXT_MAX) == 0) return;
+
+  strncpy(l_last, text, CANVAS_TEXT_MAX);
+  l_last[CANVAS_TEXT_MAX] = 0;
+  l_fg         = textColor;
+  l_bg         = background;
+  l_generation = ValueWidget::currentGeneration();
+  l_valid      = true;
+
+  // the text is clipped to the field so its box is exactly the fill
+  if (!glyphCache.drawTextBox(l_x, l_y, l_width, l_height, l_textX, l_textY, l_last, l_font, textColor, background)) {
+    tft.fillRect(l_x, l_y, l_width, l_height, background);
+    tft.setFont(l_font);
+    tft.setCursor(l_textX, l_textY);
+    tft.print(l_last);
+  }
+}
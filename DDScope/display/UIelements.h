@@ -9,24 +9,30 @@
 
 #define BUTTON_RADIUS 7
 
+#define CANVAS_ARENA_PIXELS (320*20) // largest CanvasPrint field, full width x 20 rows
+#define CANVAS_TEXT_MAX          63  // longest text printed into a canvas field
+
 //----------------------------------------------------------
 // Button element
 //----------------------------------------------------------
 class Button {
   
 	public:
-    // constructor
+    // constructor, the colors point to the theme globals and are read at every draw,
+    // so that buttons follow setNightMode(); they must outlive the button. colorBehind is the surface the button
+    // sits on and shows in the rounded corners, NULL for the page background.
     Button(
       int           x,
       int           y,
       uint16_t      width,
       uint16_t      height,
-      uint16_t      colorActive,
-      uint16_t      colorNotActive,
-      uint16_t      colorBorder,
+      const uint16_t* colorActive,
+      const uint16_t* colorNotActive,
+      const uint16_t* colorBorder,
       uint8_t       fontCharWidth,
       uint8_t       fontCharHeight,
-      const char*   label);
+      const char*   label,
+      const uint16_t* colorBehind = NULL);
 
     void draw  (int x, int y, uint16_t width, uint16_t height, const char* label, bool active);
     void draw  (int x, int y,                                  const char* label, bool active);
@@ -38,10 +44,10 @@ class Button {
     int           b_y;
     uint16_t      b_width; 
     uint16_t      b_height;
-    uint16_t      colorActive;
-    uint16_t      b_colorActive;
-    uint16_t      b_colorNotActive;
-    uint16_t      b_colorBorder;
+    const uint16_t* b_colorActive;
+    const uint16_t* b_colorNotActive;
+    const uint16_t* b_colorBorder;
+    const uint16_t* b_colorBehind;
     uint8_t       b_fontCharWidth;
     uint8_t       b_fontCharHeight;      
     const char*   b_label;
@@ -62,11 +68,82 @@ class CanvasPrint {
 
     void  printLJ(int x, int y, uint16_t width, uint16_t height, const char* c_label, bool warning);
     void  printLJ(int x, int y, uint16_t width, uint16_t height,         int d_label, bool warning);
+
+    // same text the double overload of printRJ() renders
+    static void formatFixed1(char* dst, double value);
    
   private:
+    void  render(int x, int y, uint16_t width, uint16_t height, const char* text, bool warning);
+
     const GFXfont *c_font;    
 };
 
+//----------------------------------------------------------
+// Retained value widget
+// Remembers the text and colors it last rendered through its CanvasPrint
+// and only draws again when one of them changes
+//----------------------------------------------------------
+class ValueWidget {
+
+	public:
+    // constructor
+    ValueWidget(CanvasPrint* canvas, int x, int y, uint16_t width, uint16_t height, bool rightJustify = true);
+
+    void set(const char* text, bool warning);
+    void set(double value, bool warning);
+    void invalidate() { w_valid = false; }
+
+    // every screen draw() clears the TFT, so forget what all widgets have shown
+    static void invalidateAll() { screenGeneration++; }
+    static uint32_t currentGeneration() { return screenGeneration; }
+
+  private:
+    bool  changed(const char* text, bool warning);
+
+    CanvasPrint*  w_canvas;
+    int           w_x;
+    int           w_y;
+    uint16_t      w_width;
+    uint16_t      w_height;
+    bool          w_rightJustify;
+    bool          w_valid = false;
+    bool          w_warning = false;
+    uint16_t      w_fg = 0;
+    uint16_t      w_bg = 0;
+    uint32_t      w_generation = 0;
+    char          w_last[CANVAS_TEXT_MAX + 1] = "";
+
+    static uint32_t screenGeneration;
+};
+
+//----------------------------------------------------------
+// Retained label widget
+// Text at a cursor position on a solid box, redrawn only on change
+//----------------------------------------------------------
+class LabelWidget {
+
+	public:
+    // constructor
+    LabelWidget(const GFXfont *font, int x, int y, uint16_t width, uint16_t height, int16_t textX, int16_t textY);
+
+    void set(const char* text, uint16_t background);
+    void invalidate() { l_valid = false; }
+
+  private:
+    const GFXfont *l_font;
+    int           l_x;
+    int           l_y;
+    uint16_t      l_width;
+    uint16_t      l_height;
+    int16_t       l_textX;
+    int16_t       l_textY;
+    bool          l_valid = false;
+    uint16_t      l_fg = 0;
+    uint16_t      l_bg = 0;
+    uint32_t      l_generation = 0;
+    char          l_last[CANVAS_TEXT_MAX + 1] = "";
+};
+
 extern Button button;
 extern CanvasPrint canvasPrint;
 
@@ -10,7 +10,13 @@
 extern USBHost myusb;
 extern USBSerial userSerial;
 
-#define SERIAL_ESP userSerial
+// the mirror link, the fake ESP32-S3 peer when testing without one
+#ifdef ENABLE_ESP_LOOPBACK
+  #include "EspLoopback.h"
+  #define SERIAL_ESP espLoopback
+#else
+  #define SERIAL_ESP userSerial
+#endif
 
 void usbBegin(void);
 void usbPollTask(void);
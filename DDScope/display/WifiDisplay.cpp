@@ -45,18 +45,37 @@
 #include "WifiDisplay.h"
 #include "../display/Display.h"
 #include "../display/UsbBridge.h"
+#include "../display/DrawRecorder.h"
+#include "../display/SdWriter.h"
 #include "miniz.h"
 #include "src/lib/tasks/OnTask.h"
 #include <Arduino.h>
 #include <SD.h>
 
-#define ACK 0x06
-#define NACK 0x15
-
 // DMAMEM is 512KB or not big enough, using PSRAM
 // PSRAM is 8 MB
-EXTMEM uint8_t compressedBuffer[COMPRESSED_BUFFER_SIZE];
-EXTMEM uint8_t uncompressedBuffer[UNCOMPRESSED_BUFFER_SIZE];
+// Two compressed buffers: the next frame is compressed into one while the
+// other is still going out over USB. compressedBuffer is the one being filled.
+EXTMEM static uint8_t frameBuffers[2][COMPRESSED_BUFFER_SIZE];
+uint8_t *compressedBuffer = frameBuffers[0];
+
+// Two capture buffers: the driver draws into captureBuffer while
+// uncompressedBuffer holds the frame that is being compressed. They are
+// swapped when a frame is taken, so drawing never touches a frame that
+// is being read and task priorities don't matter for the mirror.
+EXTMEM static uint8_t captureBuffers[2][UNCOMPRESSED_BUFFER_SIZE] __attribute__((aligned(4)));
+uint8_t *captureBuffer = captureBuffers[0];
+uint8_t *uncompressedBuffer = captureBuffers[1];
+
+#ifdef ENABLE_TFT_TILES
+static uint32_t sentTileHash[TILE_COUNT];  // tiles the client shows
+static uint32_t tileHash[TILE_COUNT];      // tiles of the frame being sent
+static uint16_t changedTiles[TILE_COUNT];
+#endif
+#ifdef ENABLE_TFT_DRAWCMDS
+static uint16_t cmdTiles[TILE_COUNT];      // drawn as pixels, sent with the commands
+static uint32_t replayedTiles[(TILE_COUNT + 31) / 32]; // the client has them as replayed text or corners
+#endif
 
 volatile bool espReady = false;
 
@@ -64,12 +83,8 @@ volatile bool espReady = false;
 enum TeensyCommState {
   WAIT_FOR_HELLO_ACK,
   WAIT_FOR_IP,
-  WAIT_FOR_IP_ACK,
   WAIT_FOR_CLIENT_CONNECTED,
-  WAIT_FOR_ESP_RECEIVED_TYPE_ACK,
-  WAIT_FOR_ESP_RECEIVED_SIZE_ACK,
-  WAIT_FOR_ESP_RECEIVED_FRAME_ACK,
-  ERROR
+  CLIENT_CONNECTED
 };
 
 TeensyCommState teensyState = WAIT_FOR_HELLO_ACK;
@@ -77,33 +92,64 @@ TeensyCommState teensyState = WAIT_FOR_HELLO_ACK;
 // =================================================================
 
 // *** Functions to enable capture a screen and redirect it to WiFi *****
+// With the mirror on every pixel is captured, so button feedback and values
+// drawn outside a screen's draw reach the client too. The enable/disable pairs
+// then only mark a screen that is still being drawn, see pushPoll().
 void WifiDisplay::enableScreenCapture(bool enable) {
   if (isScreenCaptureEnabled) {
     //memset(uncompressedBuffer, 0, COMPRESSED_BUFFER_SIZE);
   }
+  drawing = enable;
+#ifdef ENABLE_TFT_MIRROR
+  isScreenCaptureEnabled = true;
+#else
   isScreenCaptureEnabled = enable;
+#endif
+}
+
+// Remember which tiles a drawing window touches, so taking a frame only has
+// to bring those tiles of the other buffer up to date
+void WifiDisplay::markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+  if (x0 >= SCREEN_WIDTH || y0 >= SCREEN_HEIGHT) return;
+  if (x1 >= SCREEN_WIDTH) x1 = SCREEN_WIDTH - 1;
+  if (y1 >= SCREEN_HEIGHT) y1 = SCREEN_HEIGHT - 1;
+  for (uint16_t ty = y0 / TILE_SIZE; ty <= y1 / TILE_SIZE; ty++) {
+    for (uint16_t tx = x0 / TILE_SIZE; tx <= x1 / TILE_SIZE; tx++) {
+      uint16_t tile = ty * TILE_COLS + tx;
+      dirtyTiles[tile >> 5] |= 1UL << (tile & 31);
+    }
+  }
+  frameDirty = true;
+  lastDrawMs = millis();
 }
 
-// ACK handler
-bool waitForEspACK(unsigned long timeoutMillis) {
-  unsigned long ackTime = millis();
+// Make the finished frame the one to compress and continue drawing into the
+// other buffer, after copying in the tiles drawn since the last swap
+void WifiDisplay::swapCaptureBuffers() {
+  uint8_t *finished = captureBuffer;
+  captureBuffer = uncompressedBuffer;
+  uncompressedBuffer = finished;
+#ifdef ENABLE_TFT_DRAWCMDS
+  drawRecorder.swap();
+#endif
 
-  while (millis() - ackTime < timeoutMillis) {
-    if (SERIAL_ESP.available()) {
-      char incoming = SERIAL_ESP.read();
-      if (incoming == ACK) {
-        return true;
+  for (uint16_t word = 0; word < (TILE_COUNT + 31) / 32; word++) {
+    uint32_t bits = dirtyTiles[word];
+    dirtyTiles[word] = 0;
+    while (bits) {
+      uint16_t tile = word * 32 + __builtin_ctz(bits);
+      bits &= bits - 1;
+      uint32_t offset = ((tile / TILE_COLS) * TILE_SIZE * SCREEN_WIDTH + (tile % TILE_COLS) * TILE_SIZE) * COLOR_DEPTH;
+      for (uint8_t y = 0; y < TILE_SIZE; y++) {
+        memcpy(captureBuffer + offset, finished + offset, TILE_SIZE * COLOR_DEPTH);
+        offset += SCREEN_WIDTH * COLOR_DEPTH;
       }
     }
-    yield();
   }
-  return false; // Timed out
 }
 
 // ==================== Deflate Compression ====================
-size_t WifiDisplay::compressWithDeflate() {
-  memset(compressedBuffer, 0, COMPRESSED_BUFFER_SIZE);
-
+size_t WifiDisplay::compressWithDeflate(int level) {
   mz_stream stream = {0};
   stream.next_in = uncompressedBuffer;
   stream.avail_in = UNCOMPRESSED_BUFFER_SIZE;
@@ -111,7 +157,7 @@ size_t WifiDisplay::compressWithDeflate() {
   stream.avail_out = COMPRESSED_BUFFER_SIZE;
 
   // Use mz_deflateInit2 with negative windowBits to get raw deflate
-  int status = mz_deflateInit2(&stream, MZ_DEFAULT_COMPRESSION, MZ_DEFLATED,
+  int status = mz_deflateInit2(&stream, level, MZ_DEFLATED,
                                -MZ_DEFAULT_WINDOW_BITS, 9, 0);
   if (status != MZ_OK) {
     SERIAL_DEBUG.println("Deflate init failed");
@@ -134,6 +180,312 @@ size_t WifiDisplay::compressWithDeflate() {
   return compressedSize;
 }
 
+static bool deflateChunk(mz_stream *stream, const uint8_t *data, size_t len, int flush) {
+  // nothing to add, mz_deflate() would answer MZ_BUF_ERROR
+  if (len == 0 && flush != MZ_FINISH) return true;
+  stream->next_in = data;
+  stream->avail_in = len;
+  int status = mz_deflate(stream, flush);
+  if (flush == MZ_FINISH) return status == MZ_STREAM_END;
+  return status == MZ_OK && stream->avail_in == 0;
+}
+
+// Deflate tiles as [tile index u16][16x16 RGB565 big-endian] each, the last
+// one finishes the stream if finish is set
+static bool deflateTileList(mz_stream *stream, const uint16_t *tiles, uint16_t count, bool finish) {
+  static uint8_t tileBuf[2 + TILE_SIZE * TILE_SIZE * COLOR_DEPTH];
+  bool ok = true;
+  for (uint16_t i = 0; ok && i < count; i++) {
+    uint16_t tile = tiles[i];
+    tileBuf[0] = tile & 0xFF;
+    tileBuf[1] = tile >> 8;
+    const uint8_t *row = uncompressedBuffer +
+        ((tile / TILE_COLS) * TILE_SIZE * SCREEN_WIDTH + (tile % TILE_COLS) * TILE_SIZE) * COLOR_DEPTH;
+    for (uint8_t y = 0; y < TILE_SIZE; y++) {
+      memcpy(tileBuf + 2 + y * TILE_SIZE * COLOR_DEPTH, row, TILE_SIZE * COLOR_DEPTH);
+      row += SCREEN_WIDTH * COLOR_DEPTH;
+    }
+    ok = deflateChunk(stream, tileBuf, sizeof(tileBuf), (finish && i == count - 1) ? MZ_FINISH : MZ_NO_FLUSH);
+  }
+  return ok;
+}
+
+#ifdef ENABLE_TFT_TILES
+// ==================== Tile Delta Compression ====================
+// The frame is split into 16x16 tiles. Each one gets a cheap hash (FNV-1a
+// over 32-bit words) and only tiles whose hash differs from the frame the
+// client already has are sent. A hash collision leaves a stale tile until the
+// next keyframe at the latest.
+static uint32_t hashTile(uint16_t tile) {
+  const uint8_t *row = uncompressedBuffer +
+      ((tile / TILE_COLS) * TILE_SIZE * SCREEN_WIDTH + (tile % TILE_COLS) * TILE_SIZE) * COLOR_DEPTH;
+  uint32_t h = 2166136261UL;
+  for (uint8_t y = 0; y < TILE_SIZE; y++) {
+    const uint32_t *word = (const uint32_t *)row;
+    for (uint8_t i = 0; i < TILE_SIZE * COLOR_DEPTH / 4; i++) h = (h ^ word[i]) * 16777619UL;
+    row += SCREEN_WIDTH * COLOR_DEPTH;
+  }
+  return h;
+}
+
+// Hash every tile and list the ones that changed, returns how many
+uint16_t WifiDisplay::findChangedTiles() {
+  uint16_t count = 0;
+  for (uint16_t tile = 0; tile < TILE_COUNT; tile++) {
+    tileHash[tile] = hashTile(tile);
+    if (tileHash[tile] != sentTileHash[tile]) changedTiles[count++] = tile;
+  }
+  return count;
+}
+
+// Deflate the changed tiles as one stream (see WifiHandController.md):
+//   [tile count u16] then per tile [tile index u16][16x16 RGB565 big-endian]
+size_t WifiDisplay::compressTiles(uint16_t tileCount, int level) {
+  mz_stream stream = {0};
+  stream.next_out = compressedBuffer;
+  stream.avail_out = COMPRESSED_BUFFER_SIZE;
+  int status = mz_deflateInit2(&stream, level, MZ_DEFLATED,
+                               -MZ_DEFAULT_WINDOW_BITS, 9, 0);
+  if (status != MZ_OK) {
+    SERIAL_DEBUG.println("Deflate init failed");
+    return 0;
+  }
+
+  uint8_t header[2] = {(uint8_t)(tileCount & 0xFF), (uint8_t)(tileCount >> 8)};
+  bool ok = deflateChunk(&stream, header, sizeof(header), MZ_NO_FLUSH) &&
+            deflateTileList(&stream, changedTiles, tileCount, true);
+  if (!ok) {
+    SERIAL_DEBUG.println("Deflate tile compression failed");
+    mz_deflateEnd(&stream);
+    return 0;
+  }
+
+  size_t compressedSize = stream.total_out;
+  mz_deflateEnd(&stream);
+  return compressedSize;
+}
+#endif
+
+#ifdef ENABLE_TFT_DRAWCMDS
+// ==================== Draw Command Frames ====================
+// The GFX calls drawn since the last frame (DrawRecorder.h), which the web
+// page replays on top of that frame, then the tiles that were drawn as pixels
+// from this frame. One raw deflate stream (see WifiHandController.md):
+//   [command bytes u32][commands][tile count u16][tiles as in a tile frame]
+size_t WifiDisplay::compressCommands(uint16_t pixelTiles, int level) {
+  mz_stream stream = {0};
+  stream.next_out = compressedBuffer;
+  stream.avail_out = COMPRESSED_BUFFER_SIZE;
+  int status = mz_deflateInit2(&stream, level, MZ_DEFLATED,
+                               -MZ_DEFAULT_WINDOW_BITS, 9, 0);
+  if (status != MZ_OK) {
+    SERIAL_DEBUG.println("Deflate init failed");
+    return 0;
+  }
+
+  uint32_t size = drawRecorder.size();
+  uint8_t header[4] = {(uint8_t)size, (uint8_t)(size >> 8), (uint8_t)(size >> 16), (uint8_t)(size >> 24)};
+  uint8_t tileHeader[2] = {(uint8_t)(pixelTiles & 0xFF), (uint8_t)(pixelTiles >> 8)};
+  bool ok = deflateChunk(&stream, header, sizeof(header), MZ_NO_FLUSH) &&
+            deflateChunk(&stream, drawRecorder.data(), size, MZ_NO_FLUSH) &&
+            deflateChunk(&stream, tileHeader, sizeof(tileHeader), pixelTiles ? MZ_NO_FLUSH : MZ_FINISH) &&
+            deflateTileList(&stream, cmdTiles, pixelTiles, true);
+  if (!ok) {
+    SERIAL_DEBUG.println("Deflate command compression failed");
+    mz_deflateEnd(&stream);
+    return 0;
+  }
+
+  size_t compressedSize = stream.total_out;
+  mz_deflateEnd(&stream);
+  return compressedSize;
+}
+#endif
+
+#ifdef ENABLE_TFT_PAL_FRAMES
+// ==================== Palette Frames ====================
+// The UI draws with a handful of colors, so a frame goes out as a palette and
+// an index per pixel, 4 bits when 16 colors do, else 8 bits. Tiles of a
+// picture (a color change at most pixels) or with colors that don't fit the
+// palette any more go as RGB565 tiles instead. One raw deflate stream of
+//   [bits u8][color count u16][colors RGB565 big-endian][indices, row by row,
+//    4 bit: first pixel in the high nibble][tile count u16][tiles]
+// with tiles as in a tile frame; their indices are 0.
+EXTMEM static uint8_t palIndices[SCREEN_WIDTH * SCREEN_HEIGHT];
+static uint16_t palColors[PAL_COLORS_MAX];
+static uint16_t palHashSlot[PAL_HASH_SLOTS]; // palette index + 1, 0 is empty
+static uint16_t palTiles[TILE_COUNT / 2];
+
+// Palette index of a color, added if there is room, -1 when the palette is full
+static int16_t paletteIndex(uint16_t color, uint16_t &count) {
+  uint16_t h = ((uint16_t)(color * 40503U) >> 7) & (PAL_HASH_SLOTS - 1);
+  while (palHashSlot[h]) {
+    if (palColors[palHashSlot[h] - 1] == color) return palHashSlot[h] - 1;
+    h = (h + 1) & (PAL_HASH_SLOTS - 1);
+  }
+  if (count == PAL_COLORS_MAX) return -1;
+  palColors[count] = color;
+  palHashSlot[h] = ++count;
+  return count - 1;
+}
+
+// Returns 0 when more than half of the tiles would be RGB565, a picture
+// screen is better off as a plain deflate frame
+size_t WifiDisplay::compressPalette(int level) {
+  const uint16_t *pixels = (const uint16_t *)uncompressedBuffer;
+  uint16_t count = 0;
+  uint16_t tileCount = 0;
+  memset(palHashSlot, 0, sizeof(palHashSlot));
+
+  for (uint16_t tile = 0; tile < TILE_COUNT; tile++) {
+    uint32_t first = (tile / TILE_COLS) * TILE_SIZE * SCREEN_WIDTH + (tile % TILE_COLS) * TILE_SIZE;
+
+    // pictures would fill the palette with colors no other tile uses
+    uint16_t changes = 0;
+    for (uint8_t y = 0; y < TILE_SIZE; y++) {
+      const uint16_t *row = pixels + first + y * SCREEN_WIDTH;
+      for (uint8_t x = 1; x < TILE_SIZE; x++) changes += (row[x] != row[x - 1]);
+    }
+    bool indexed = changes <= PAL_TILE_CHANGES_MAX;
+
+    uint16_t lastColor = 0;
+    int16_t lastIndex = -1;
+    for (uint8_t y = 0; indexed && y < TILE_SIZE; y++) {
+      const uint16_t *row = pixels + first + y * SCREEN_WIDTH;
+      uint8_t *index = palIndices + first + y * SCREEN_WIDTH;
+      for (uint8_t x = 0; x < TILE_SIZE; x++) {
+        if (lastIndex < 0 || row[x] != lastColor) {
+          lastColor = row[x];
+          lastIndex = paletteIndex(lastColor, count);
+          if (lastIndex < 0) {
+            indexed = false;
+            break;
+          }
+        }
+        index[x] = lastIndex;
+      }
+    }
+
+    if (!indexed) {
+      if (tileCount == TILE_COUNT / 2) return 0;
+      palTiles[tileCount++] = tile;
+      for (uint8_t y = 0; y < TILE_SIZE; y++) memset(palIndices + first + y * SCREEN_WIDTH, 0, TILE_SIZE);
+    }
+  }
+
+  // pack to 4 bits in place, each byte is written behind the ones still read
+  uint8_t bits = (count <= 16) ? 4 : 8;
+  size_t indexBytes = SCREEN_WIDTH * SCREEN_HEIGHT;
+  if (bits == 4) {
+    indexBytes /= 2;
+    for (size_t i = 0; i < indexBytes; i++) palIndices[i] = (palIndices[2 * i] << 4) | palIndices[2 * i + 1];
+  }
+
+  static uint8_t header[3 + PAL_COLORS_MAX * COLOR_DEPTH];
+  header[0] = bits;
+  header[1] = count & 0xFF;
+  header[2] = count >> 8;
+  // the colors were read from the big-endian buffer, store their bytes as they were
+  for (uint16_t i = 0; i < count; i++) {
+    header[3 + i * 2] = palColors[i] & 0xFF;
+    header[4 + i * 2] = palColors[i] >> 8;
+  }
+  uint8_t tileHeader[2] = {(uint8_t)(tileCount & 0xFF), (uint8_t)(tileCount >> 8)};
+
+  mz_stream stream = {0};
+  stream.next_out = compressedBuffer;
+  stream.avail_out = COMPRESSED_BUFFER_SIZE;
+  int status = mz_deflateInit2(&stream, level, MZ_DEFLATED,
+                               -MZ_DEFAULT_WINDOW_BITS, 9, 0);
+  if (status != MZ_OK) {
+    SERIAL_DEBUG.println("Deflate init failed");
+    return 0;
+  }
+  bool ok = deflateChunk(&stream, header, 3 + count * COLOR_DEPTH, MZ_NO_FLUSH) &&
+            deflateChunk(&stream, palIndices, indexBytes, MZ_NO_FLUSH) &&
+            deflateChunk(&stream, tileHeader, sizeof(tileHeader), tileCount ? MZ_NO_FLUSH : MZ_FINISH) &&
+            deflateTileList(&stream, palTiles, tileCount, true);
+  if (!ok) {
+    SERIAL_DEBUG.println("Deflate palette compression failed");
+    mz_deflateEnd(&stream);
+    return 0;
+  }
+
+  size_t compressedSize = stream.total_out;
+  mz_deflateEnd(&stream);
+  return compressedSize;
+}
+#endif
+
+// ==================== Adaptive Codec Selection ====================
+// last codec chooseCodec() may pick for a keyframe
+#ifdef ENABLE_TFT_PAL_FRAMES
+  #define CODEC_LAST_KEYFRAME CODEC_PAL
+#else
+  #define CODEC_LAST_KEYFRAME CODEC_DEF
+#endif
+
+// Screens of large flat fills RLE well, text heavy ones need deflate. Count
+// the color changes along every 8th row to tell them apart.
+uint8_t WifiDisplay::classifyFrame() {
+  uint32_t changes = 0;
+  for (uint16_t y = 0; y < SCREEN_HEIGHT; y += 8) {
+    const uint16_t *row = (const uint16_t *)uncompressedBuffer + y * SCREEN_WIDTH;
+    for (uint16_t x = 1; x < SCREEN_WIDTH; x++) changes += (row[x] != row[x - 1]);
+  }
+  uint32_t pixels = (SCREEN_HEIGHT / 8) * SCREEN_WIDTH;
+  return (changes * FILL_RUNS_PER_PIXEL < pixels) ? FRAME_CLASS_FILL : FRAME_CLASS_DETAIL;
+}
+
+// Keyframe codec with the lowest compress plus transfer time for this kind
+// of screen. A codec that wasn't measured yet is tried first, and every
+// CODEC_EXPLORE_FRAMES keyframes the one measured longest ago gets another
+// turn so the averages follow the screens. RAW is never tried for its own
+// sake, its size is known and it only wins on a fast link.
+uint8_t WifiDisplay::chooseCodec(uint8_t frameClass) {
+  CodecStats *s = stats[frameClass];
+  keyframes++;
+
+  for (uint8_t c = CODEC_RLE; c <= CODEC_LAST_KEYFRAME; c++) {
+    if (s[c].frames == 0) return c;
+  }
+
+  if (keyframes % CODEC_EXPLORE_FRAMES == 0) {
+    uint8_t oldest = CODEC_DEF;
+    for (uint8_t c = CODEC_RLE; c <= CODEC_LAST_KEYFRAME; c++) {
+      if (c != chosen[frameClass] && s[c].lastUsed < s[oldest].lastUsed) oldest = c;
+    }
+    if (oldest != chosen[frameClass]) return oldest;
+  }
+
+  float bestCost = 0;
+  float fastCost = 0;
+  for (uint8_t c = CODEC_RAW; c <= CODEC_LAST_KEYFRAME; c++) {
+    float bytes = s[c].frames ? s[c].bytes : UNCOMPRESSED_BUFFER_SIZE;
+    float cost = s[c].compressUs + bytes * 1000.0f / linkRate; // us
+    if (c == CODEC_DEF_FAST) fastCost = cost;
+    if (c == CODEC_DEF) deflateFast[frameClass] = fastCost < cost;
+    if (c == CODEC_RAW || cost < bestCost) {
+      bestCost = cost;
+      chosen[frameClass] = c;
+    }
+  }
+  return chosen[frameClass];
+}
+
+void WifiDisplay::recordCodec(uint8_t frameClass, uint8_t codec, uint32_t us, size_t bytes) {
+  CodecStats &s = stats[frameClass][codec];
+  if (s.frames == 0) {
+    s.compressUs = us;
+    s.bytes = bytes;
+  } else {
+    s.compressUs += (us - s.compressUs) * CODEC_STATS_WEIGHT;
+    s.bytes += (bytes - s.bytes) * CODEC_STATS_WEIGHT;
+  }
+  s.frames++;
+  s.lastUsed = keyframes;
+}
+
 // ==================== RLE Compression Function ====================
 // This function implements a Run-Length Encoding (RLE) compression algorithm
 // tailored for 16-bit RGB565 pixel data. It compresses a framebuffer of
@@ -183,239 +535,531 @@ size_t WifiDisplay::compressWithRLE() {
 }
 
 // Teensy4.1 and ESP32-S3 both have handshake State Machines
+// Every message is framed, see WifiDisplay.h and WifiHandController.md
 // ============== State Flow ===============================
-// Command	         Byte	     Meaning
-// HELLO	           'H'	   Teensy says "I'm alive"
-// HELLO_ACK	       'A'	   ESP32 says "I hear you"
-// IP_START	         'I'	   ESP32 sends IP address (e.g., I192.168.1.55\n)
-// CLIENT_CONNECTED  'X'	   ESP says: Client is connected
-// ACK	             'K'	   Teensy acknowledgement
-// RESET	           'R'	   From ESP: Reset whole state machine
-// ==> BOTH are READY, Teensy can send frames
-// RESET ESP32 FRAME 'Z'     From Teensy to ESP32 
+// Message           From     Meaning
+// HELLO             Teensy   "I'm alive", every second until answered
+// HELLO_ACK         ESP32    "I hear you"
+// IP_REQUEST        Teensy   send your IP address
+// IP                ESP32    IP address text (e.g., 192.168.1.55)
+// CLIENT            ESP32    Web client is connected
+// ACK               both     acknowledges the message with the seq in the payload
+// ==> BOTH are READY, Teensy can send KEYFRAME and DELTA frames, one at a
+//     time, each ACKed by the ESP32
+// RESYNC            ESP32    a frame was lost or bad, next frame is a keyframe
+// TOUCH             ESP32    touch on the web page
+// RESET             ESP32    Reset whole state machine
 
 // ======== Teensy to ESP communication State Machine ========
 void WifiDisplay::espPoll() {
-  if (SERIAL_ESP.available()) {
-    char isItReset = SERIAL_ESP.peek();
-    if (isItReset == 'R') {
-      SERIAL_ESP.read(); // consume it
-      Serial.println("Received reset signal 'R'");
-      espReady = false;
-      teensyState = WAIT_FOR_HELLO_ACK;
-      return;
-    }
-  }
-  
-  if (!espReady && SERIAL_ESP.available()) {
-    char peekChar = SERIAL_ESP.peek();
-    // Touch is running in different RTOS process and timing
-    if (peekChar == 'T') return;
-
-    char incoming = SERIAL_ESP.read();
-
-    switch (teensyState) {
-    case WAIT_FOR_HELLO_ACK:
-      if (incoming == 'A') {
-        SERIAL_DEBUG.println("Got HELLO_ACK");
-        teensyState = WAIT_FOR_IP;
-        SERIAL_ESP.write('I');
-        SERIAL_ESP.flush();
-      }
-    break;
-
-    case WAIT_FOR_IP:
-      if (incoming == 'I') {
-        String ipStr = "";
-        while (SERIAL_ESP.available()) {
-          char c = SERIAL_ESP.read();
-          if (c == '\n')
-            break;
-          ipStr += c;
-        }
-        SERIAL_DEBUG.print("IP Address: ");
-        SERIAL_DEBUG.println(ipStr);
-        if (display.currentScreen == HOME_SCREEN) {
-          tft.fillRect(170, 300, 140, 20, butBackground); // Clear old IP area
-          tft.setCursor(170, 312);
-          tft.print("I");
-          tft.print(ipStr);
-        }
-        delay(1);
-        SERIAL_ESP.write('K'); // IP ACK
-        SERIAL_ESP.flush();
-        teensyState = WAIT_FOR_CLIENT_CONNECTED;
-      }
-    break;
- 
-    case WAIT_FOR_CLIENT_CONNECTED:
-      if (incoming == 'X') {
-        SERIAL_DEBUG.println("Web Client Connected");
-        SERIAL_ESP.write('K'); // Client Connect ACK
-        SERIAL_ESP.flush();
-        espReady = true;
-        teensyState = WAIT_FOR_ESP_RECEIVED_TYPE_ACK;
-      } else if (incoming == 'I') {
-        String ipStr = "";
-        while (SERIAL_ESP.available()) {
-          char c = SERIAL_ESP.read();
-          if (c == '\n')
-            break;
-          ipStr += c;
-        }
-        SERIAL_DEBUG.print("IP Address: ");
-        SERIAL_DEBUG.println(ipStr);
-        delay(1);
-        SERIAL_ESP.write('K'); // IP ACK
-        SERIAL_ESP.flush();
-        espReady = false;
-        teensyState = WAIT_FOR_CLIENT_CONNECTED;
-      } else {
-        espReady = false;
-        teensyState = WAIT_FOR_HELLO_ACK;
-      }
-    break;
+  // a message that stopped half way is dropped, the sender resends or resyncs
+  if (rxLen && millis() - rxTime > LINK_RX_TIMEOUT_MS) rxLen = 0;
 
-    default:
-    break;
-    }
-  }
+  while (SERIAL_ESP.available()) receiveByte(SERIAL_ESP.read());
+
+  pushPoll();
+  espSendPoll();
 
   // Periodically send HELLO if needed
   if (!espReady && teensyState == WAIT_FOR_HELLO_ACK) {
     static unsigned long lastHelloTime = 0;
     if (millis() - lastHelloTime > 1000) {
       SERIAL_DEBUG.println("Sending HELLO...");
-      SERIAL_ESP.write('H');
-      SERIAL_ESP.flush();
+      sendMessage(MSG_HELLO, nullptr, 0);
       lastHelloTime = millis();
     }
   }
 }
 
-// Z (0x5A)= Reset ESP32-S3 state
-// T (0x54)= Touch
-// ================ Send Buffer =================================
+// Collect one message: hunt for the sync bytes, then header, payload and CRC.
+// Anything that doesn't add up is dropped and the search starts over.
+void WifiDisplay::receiveByte(uint8_t c) {
+  if (rxLen == 0 && c != LINK_SYNC0) return;
+  if (rxLen == 1 && c != LINK_SYNC1) {
+    rxLen = (c == LINK_SYNC0) ? 1 : 0;
+    return;
+  }
+  if (rxLen == 0) rxTime = millis();
+  rxBuf[rxLen++] = c;
+  if (rxLen < LINK_HEADER_SIZE) return;
+
+  uint32_t len = rxBuf[5] | (rxBuf[6] << 8) | ((uint32_t)rxBuf[7] << 16) | ((uint32_t)rxBuf[8] << 24);
+  if (len > LINK_RX_PAYLOAD_MAX) {
+    SERIAL_DEBUG.println("ESP message too long, dropped");
+    rxLen = 0;
+    return;
+  }
+  if (rxLen < LINK_HEADER_SIZE + len + LINK_CRC_SIZE) return;
+  rxLen = 0;
+
+  const uint8_t *crcBytes = rxBuf + LINK_HEADER_SIZE + len;
+  uint32_t crc = crcBytes[0] | (crcBytes[1] << 8) | ((uint32_t)crcBytes[2] << 16) | ((uint32_t)crcBytes[3] << 24);
+  if ((uint32_t)mz_crc32(MZ_CRC32_INIT, rxBuf + 2, LINK_HEADER_SIZE - 2 + len) != crc) {
+    SERIAL_DEBUG.println("ESP message CRC error, dropped");
+    return;
+  }
+  handleMessage(rxBuf[2], rxBuf[3] | (rxBuf[4] << 8), rxBuf + LINK_HEADER_SIZE, len);
+}
+
+void WifiDisplay::handleMessage(uint8_t type, uint16_t seq, const uint8_t *payload, uint32_t len) {
+  switch (type) {
+  case MSG_RESET:
+    Serial.println("Received RESET");
+    resetLink();
+  break;
+
+  case MSG_HELLO_ACK:
+    if (teensyState != WAIT_FOR_HELLO_ACK) break;
+    SERIAL_DEBUG.println("Got HELLO_ACK");
+    teensyState = WAIT_FOR_IP;
+    sendMessage(MSG_IP_REQUEST, nullptr, 0);
+  break;
+
+  case MSG_IP:
+    showIp(payload, len);
+    sendAck(seq);
+    // the ESP sends its IP again when the web client went away
+    if (espReady) abortSend("Web Client Disconnected");
+    espReady = false;
+    teensyState = WAIT_FOR_CLIENT_CONNECTED;
+  break;
+
+  case MSG_CLIENT:
+    if (teensyState != WAIT_FOR_CLIENT_CONNECTED) break;
+    SERIAL_DEBUG.println("Web Client Connected");
+    sendAck(seq);
+    espReady = true;
+    frameDirty = true; // new client has nothing on screen yet
+    keyframeDue = true;
+    framePending = false;
+    sendState = SEND_IDLE;
+    sendTimeouts = 0;
+    teensyState = CLIENT_CONNECTED;
+  break;
+
+  case MSG_ACK:
+    // an ACK for a frame that already timed out is stale, ignore it
+    if (len < 2 || sendState != SEND_WAIT_ACK) break;
+    if ((uint16_t)(payload[0] | (payload[1] << 8)) != sendSeq) break;
+    // keyframes are big enough to time the link, ESP turnaround included
+    if (sendHeader[2] == MSG_KEYFRAME) {
+      uint32_t us = micros() - sendStartUs;
+      float rate = (sizeof(sendHeader) + sendSize + LINK_CRC_SIZE) * 1000.0f / (us ? us : 1);
+      linkRate += (rate - linkRate) * CODEC_STATS_WEIGHT;
+    }
+    sendState = SEND_IDLE;
+    sendTimeouts = 0;
+  break;
+
+  case MSG_RESYNC:
+    // the queued frame may be a delta on top of what the ESP lost
+    SERIAL_DEBUG.println("ESP requested resync");
+    framePending = false;
+    frameDirty = true;
+    keyframeDue = true;
+    if (sendState == SEND_WAIT_ACK) sendState = SEND_IDLE;
+  break;
+
+  case MSG_TOUCH: {
+    if (len < 4) break;
+    uint8_t next = (touchHead + 1) % TOUCH_QUEUE_SIZE;
+    if (next == touchTail) break; // full, the touch task is behind
+    touchX[touchHead] = payload[0] | (payload[1] << 8);
+    touchY[touchHead] = payload[2] | (payload[3] << 8);
+    touchHead = next;
+  } break;
+
+  default:
+    SERIAL_DEBUG.printf("Unknown ESP message 0x%02X\n", type);
+  break;
+  }
+}
+
+bool WifiDisplay::getTouch(uint16_t &x, uint16_t &y) {
+  if (touchTail == touchHead) return false;
+  x = touchX[touchTail];
+  y = touchY[touchTail];
+  touchTail = (touchTail + 1) % TOUCH_QUEUE_SIZE;
+  return true;
+}
+
+void WifiDisplay::showIp(const uint8_t *text, uint32_t len) {
+  char ipStr[LINK_RX_PAYLOAD_MAX + 1];
+  memcpy(ipStr, text, len);
+  ipStr[len] = 0;
+  SERIAL_DEBUG.print("IP Address: ");
+  SERIAL_DEBUG.println(ipStr);
+  if (display.currentScreen == HOME_SCREEN && teensyState == WAIT_FOR_IP) {
+    tft.fillRect(170, 300, 140, 20, butBackground); // Clear old IP area
+    tft.setCursor(170, 312);
+    tft.print("I");
+    tft.print(ipStr);
+  }
+}
+
+// Start over from HELLO, whatever was on its way is gone
+void WifiDisplay::resetLink() {
+  espReady = false;
+  sendState = SEND_IDLE;
+  framePending = false;
+  rxLen = 0;
+  teensyState = WAIT_FOR_HELLO_ACK;
+}
+
+// Short message in one go. A frame that is still going out is cut off; the
+// ESP drops it on the CRC and the next frame is a keyframe.
+void WifiDisplay::sendMessage(uint8_t type, const uint8_t *payload, uint16_t len) {
+  if (sendState != SEND_IDLE && sendState != SEND_WAIT_ACK) abortSend("Frame cut off by a message");
+  uint8_t header[LINK_HEADER_SIZE] = { LINK_SYNC0, LINK_SYNC1, type,
+    (uint8_t)(txSeq & 0xFF), (uint8_t)(txSeq >> 8),
+    (uint8_t)(len & 0xFF), (uint8_t)(len >> 8), 0, 0 };
+  txSeq++;
+  uint32_t crc = mz_crc32(MZ_CRC32_INIT, header + 2, LINK_HEADER_SIZE - 2);
+  if (len) crc = mz_crc32(crc, payload, len);
+  uint8_t crcBytes[LINK_CRC_SIZE] = { (uint8_t)crc, (uint8_t)(crc >> 8), (uint8_t)(crc >> 16), (uint8_t)(crc >> 24) };
+  SERIAL_ESP.write(header, LINK_HEADER_SIZE);
+  if (len) SERIAL_ESP.write(payload, len);
+  SERIAL_ESP.write(crcBytes, LINK_CRC_SIZE);
+  SERIAL_ESP.flush();
+}
+
+void WifiDisplay::sendAck(uint16_t seq) {
+  uint8_t payload[2] = { (uint8_t)(seq & 0xFF), (uint8_t)(seq >> 8) };
+  sendMessage(MSG_ACK, payload, 2);
+}
+
+// ================ Frame Push =================================
+// A screen that finished drawing asks for a frame. It goes out from pushPoll()
+// right away unless the rate limit holds it back a little.
 void WifiDisplay::sendFrameToEsp(uint8_t frameType) {
-  if (!espReady) {
-    SERIAL_DEBUG.println("ESP not ready");
+  pushRequested = true;
+  pushType = frameType;
+  pushPoll();
+}
+
+// Runs from the espPoll task. Takes a frame once something was drawn and the
+// drawing has settled, at most MIRROR_MAX_FPS times a second; everything
+// drawn in between goes out together in the next frame. Nothing drawn, no
+// frame, so an idle screen costs no bandwidth.
+void WifiDisplay::pushPoll() {
+#ifdef ENABLE_TFT_RECORDING
+  // a session recording takes frames with or without a web client, but not
+  // while its ring is backed up; it gets a keyframe once that is over
+  bool backedUp = sdWriter.isBackedUp();
+  if (recordBackedUp && !backedUp) {
+    keyframeDue = true;
+    frameDirty = true;
+  }
+  recordBackedUp = backedUp;
+  if ((!espReady && (!sdWriter.isRecording() || backedUp)) || !frameDirty || framePending) return;
+#else
+  if (!espReady || !frameDirty || framePending) return;
+#endif
+  unsigned long now = millis();
+  if (drawing && now - lastDrawMs < MIRROR_DRAWING_MAX_MS) return;
+  if (now - lastPushMs < 1000 / MIRROR_MAX_FPS) return;
+  // a screen that asked is done drawing, otherwise wait for a quiet moment
+  if (!pushRequested && now - lastDrawMs < MIRROR_SETTLE_MS) return;
+
+  lastPushMs = now;
+  pushRequested = false;
+  takeFrame(pushType);
+  pushType = FRAME_TYPE_DEF;
+}
+
+// ================ Send Buffer =================================
+// Compress the captured frame and queue it for espSendPoll(). Returns right
+// away; while one frame is on its way the next can be compressed into the
+// other buffer.
+void WifiDisplay::takeFrame(uint8_t frameType) {
+
+  swapCaptureBuffers();
+
+  uint8_t codec;
+  if (frameType == FRAME_TYPE_RAW) codec = CODEC_RAW;
+  else if (frameType == FRAME_TYPE_RLE) codec = CODEC_RLE;
+  else if (frameType == FRAME_TYPE_DEF) codec = CODEC_DEF;
+  else {
+    SERIAL_DEBUG.printf("Unknown FRAME TYPE");
+    cmdBaseValid = false;
     return;
   }
-  // Check if any status byte is available from ESP
-  if (SERIAL_ESP.available()) {
-    char peekChar = SERIAL_ESP.peek();
-    //SERIAL_DEBUG.print(peekChar);
-    if (peekChar == 'T' || 'R') return;
-  }
-  
-  //long startTime = millis();
-   // Reset the ESP32 frame state
-   //SERIAL_DEBUG.println("Sending 'Z'");
-   SERIAL_ESP.write('Z');
-   SERIAL_ESP.flush();
-   delay(1);
-   
-  // clear any junk
-  while (SERIAL_ESP.available()) {
-    SERIAL_ESP.read();
-  }
-  
-  // === Prepare Size of Payload ===
-  size_t bufSize = 0;
-  const uint8_t *bufferToSend = nullptr;
 
-  if (frameType == FRAME_TYPE_RLE) {
-    bufSize = compressWithRLE();
-    if (bufSize == 0)
-      return;
-    bufferToSend = compressedBuffer;
-    // SERIAL_DEBUG.println("Sending RLE frame to ESP32-S3");
-  } else if (frameType == FRAME_TYPE_DEF) {
-    bufSize = compressWithDeflate();
-    if (bufSize == 0)
+#ifdef ENABLE_TFT_TILES
+  // Deflate frames become tile deltas unless a keyframe is due or most of
+  // the screen changed anyway
+  uint16_t tileCount = 0;
+  bool hashed = false;
+  if (frameType == FRAME_TYPE_DEF) {
+    tileCount = findChangedTiles();
+    hashed = true;
+    if (tileCount == 0 && !keyframeDue) {
+      frameDirty = false;
       return;
-    bufferToSend = compressedBuffer;
-    //SERIAL_DEBUG.println("Sending Deflate frame to ESP32-S3");
-  } else if (frameType == FRAME_TYPE_RAW) {
-    bufSize = UNCOMPRESSED_BUFFER_SIZE;
-    bufferToSend = uncompressedBuffer;
-  } else {
-    SERIAL_DEBUG.printf("Unknown FRAME TYPE");
+    }
+    if (!keyframeDue && tileCount <= TILE_DELTA_MAX) codec = CODEC_TILES;
   }
+#endif
+#ifdef ENABLE_TFT_DRAWCMDS
+  // A delta goes as the draw calls when they and the tiles drawn as pixels
+  // come to less than the changed tiles. The client must show the frame the
+  // calls were drawn on, the one taken last time. Tiles the last one left as
+  // replayed text go along as pixels.
+  uint16_t pixelTiles = 0;
+  if (codec == CODEC_TILES && cmdBaseValid && drawRecorder.isValid()) {
+    const uint32_t tileBytes = 2 + TILE_SIZE * TILE_SIZE * COLOR_DEPTH;
+    pixelTiles = drawRecorder.pixelTiles(cmdTiles, replayedTiles);
+    if (drawRecorder.size() + pixelTiles * tileBytes < tileCount * tileBytes) codec = CODEC_CMDS;
+  }
+#endif
 
-  //SERIAL_DEBUG.printf("Sending bufSize (%u bytes) as [0x%02X 0x%02X 0x%02X 0x%02X]\n",
-  //  bufSize,
-  //  (uint8_t)(bufSize & 0xFF),
-  //  (uint8_t)((bufSize >> 8) & 0xFF),
-  //  (uint8_t)((bufSize >> 16) & 0xFF),
-  //  (uint8_t)((bufSize >> 24) & 0xFF)
-  //);
-
-  // === Send Type and Size Header ===
-  SERIAL_ESP.write(frameType);
-  SERIAL_ESP.write((uint8_t)(bufSize & 0xFF));
-  SERIAL_ESP.write((uint8_t)((bufSize >> 8) & 0xFF));
-  SERIAL_ESP.write((uint8_t)((bufSize >> 16) & 0xFF));
-  SERIAL_ESP.write((uint8_t)((bufSize >> 24) & 0xFF));
-  SERIAL_ESP.flush();
-  delay(1);
+  uint8_t frameClass = classifyFrame();
+#ifdef ENABLE_TFT_ADAPTIVE
+  if (codec == CODEC_DEF) codec = chooseCodec(frameClass);
+#elif defined(ENABLE_TFT_PAL_FRAMES)
+  if (codec == CODEC_DEF) codec = CODEC_PAL;
+#endif
 
-  // === Wait for ACK ===
-  if (!waitForEspACK(2000)) {
-    SERIAL_DEBUG.println("ESP32 header processing timeout. Aborting transfer.");
-    espReady = false;
+  // palette frames and deltas use the deflate level that is winning for keyframes
+  int level = deflateFast[frameClass] ? MZ_BEST_SPEED : MZ_DEFAULT_COMPRESSION;
+
+  // === Prepare Size of Payload ===
+  uint32_t startUs = micros();
+  size_t bufSize = 0;
+
+  switch (codec) {
+  case CODEC_RAW:
+    // copy, the next swap reuses this buffer while it may still be sent
+    memcpy(compressedBuffer, uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
+    bufSize = UNCOMPRESSED_BUFFER_SIZE;
+  break;
+  case CODEC_RLE:
+    bufSize = compressWithRLE();
+  break;
+#ifdef ENABLE_TFT_PAL_FRAMES
+  case CODEC_PAL:
+    bufSize = compressPalette(level);
+  break;
+#endif
+  case CODEC_DEF_FAST:
+    bufSize = compressWithDeflate(MZ_BEST_SPEED);
+  break;
+  case CODEC_DEF:
+    bufSize = compressWithDeflate(MZ_DEFAULT_COMPRESSION);
+  break;
+#ifdef ENABLE_TFT_TILES
+  case CODEC_TILES:
+    bufSize = compressTiles(tileCount, level);
+  break;
+#endif
+#ifdef ENABLE_TFT_DRAWCMDS
+  case CODEC_CMDS:
+    bufSize = compressCommands(pixelTiles, level);
+  break;
+#endif
+  }
+  if (bufSize == 0 && frameType == FRAME_TYPE_DEF && (codec == CODEC_RLE || codec == CODEC_PAL)) {
+    // busy screen, RLE didn't fit or too much of it is a picture for the
+    // palette; count it as a full buffer so it isn't picked again soon
+    recordCodec(frameClass, codec, micros() - startUs, COMPRESSED_BUFFER_SIZE);
+    codec = CODEC_DEF;
+    startUs = micros();
+    bufSize = compressWithDeflate(MZ_DEFAULT_COMPRESSION);
+  }
+  if (bufSize == 0) {
+    cmdBaseValid = false; // the client stays on an older frame
     return;
   }
-  //SERIAL_DEBUG.println("Got buffer size ACK");
+  recordCodec(frameClass, codec, micros() - startUs, bufSize);
 
-  // --- Send Payload in 64-byte Chunks with Flow Control ---
-  int totalSent = 0;
-  const size_t packetSize = 64;
+  if (codec == CODEC_RAW) frameType = FRAME_TYPE_RAW;
+  else if (codec == CODEC_RLE) frameType = FRAME_TYPE_RLE;
+  else if (codec == CODEC_PAL) frameType = FRAME_TYPE_PAL;
+  else if (codec == CODEC_TILES) frameType = FRAME_TYPE_TIL;
+  else if (codec == CODEC_CMDS) frameType = FRAME_TYPE_CMD;
+  else frameType = FRAME_TYPE_DEF;
 
-  for (size_t i = 0; i < bufSize; i += packetSize) {
-    int chunkSize = min(packetSize, bufSize - i);
+#ifdef ENABLE_TFT_TILES
+  // The client will show these tiles once the frame is through; a transfer
+  // that fails asks for a keyframe, so the hashes can be taken now and the
+  // next frame is a delta on top of this one even while it is still queued.
+  if (codec == CODEC_TILES || codec == CODEC_CMDS) {
+    for (uint16_t i = 0; i < tileCount; i++) sentTileHash[changedTiles[i]] = tileHash[changedTiles[i]];
+    if (++framesSinceKeyframe >= TILE_KEYFRAME_FRAMES) keyframeDue = true;
+  } else if (hashed) {
+    memcpy(sentTileHash, tileHash, sizeof(sentTileHash));
+    framesSinceKeyframe = 0;
+    keyframeDue = false;
+  } else {
+    keyframeDue = true; // tile hashes weren't taken for this frame
+  }
+#endif
 
-    // Wait until there's space to send the next chunk
-    while (SERIAL_ESP.availableForWrite() < chunkSize) {
-      yield(); // Let background USB and other tasks run (required for correct operation)
+  cmdBaseValid = true;
+  frameDirty = false;
+#ifdef ENABLE_TFT_DRAWCMDS
+  // Replayed text and corners may be off by a pixel on the client. Their tiles
+  // get a hash that can't match, so they count as changed and the next frame,
+  // taken as soon as the frame rate allows, sends them as pixels. The ones this frame had
+  // left over from the last one went as pixels already.
+  if (codec == CODEC_CMDS) {
+    uint32_t inexact[(TILE_COUNT + 31) / 32];
+    drawRecorder.inexactTiles(inexact);
+    for (uint16_t word = 0; word < (TILE_COUNT + 31) / 32; word++) {
+      uint32_t bits = inexact[word] & ~replayedTiles[word];
+      replayedTiles[word] = bits;
+      if (bits) frameDirty = true;
+      while (bits) {
+        uint16_t tile = word * 32 + __builtin_ctz(bits);
+        bits &= bits - 1;
+        sentTileHash[tile] = tileHash[tile] ^ 1;
+      }
     }
-
-    int sent = SERIAL_ESP.write(bufferToSend + i, chunkSize);
-    totalSent += sent;
-    delayMicroseconds(100); // Tune this if needed
+  } else {
+    memset(replayedTiles, 0, sizeof(replayedTiles)); // every tile that differs went as pixels
   }
-  SERIAL_ESP.flush();
-  //SERIAL_DEBUG.println("Got frame sent ACK");
+#endif
+#ifdef ENABLE_TFT_RECORDING
+  if (!sdWriter.recordFrame(frameType, frameType == FRAME_TYPE_TIL || frameType == FRAME_TYPE_CMD,
+                            compressedBuffer, bufSize) && !sdWriter.isBackedUp()) {
+    // the recording lost a frame and needs a keyframe, even if nothing is drawn
+    keyframeDue = true;
+    frameDirty = true;
+  }
+  if (!espReady) return; // recording only
+#endif
+
+  pendingType = frameType;
+  pendingBuffer = compressedBuffer;
+  pendingSize = bufSize;
+  framePending = true;
+  compressedBuffer = (compressedBuffer == frameBuffers[0]) ? frameBuffers[1] : frameBuffers[0];
 
   //unsigned long elapsed = millis() - startTime;
-  //SERIAL_DEBUG.printf("Sent %d bytes in %d ms\n", totalSent, elapsed);
-  // NOTE: the longest elapsed time to compress and send is approx 143 msec.
+  //SERIAL_DEBUG.printf("Compressed %d bytes in %d ms\n", bufSize, elapsed);
+  // NOTE: compress and send used to block for up to approx 143 msec.
+  espSendPoll(); // start sending if the channel is idle
+}
+
+// Drop the frame on its way and the queued one, the client gets a keyframe
+void WifiDisplay::abortSend(const char *reason) {
+  SERIAL_DEBUG.println(reason);
+  sendState = SEND_IDLE;
+  framePending = false;
+  frameDirty = true;
+#ifdef ENABLE_TFT_TILES
+  keyframeDue = true;
+#endif
+}
+
+// ============== Frame sender State Machine =====================
+// Runs from the espPoll task. Each call writes as much of the frame as the
+// USB serial buffer takes and returns; nothing here waits.
+//   SEND_IDLE -> SEND_HEADER -> [sync][type][seq][len][codec] -> SEND_PAYLOAD
+//   -> SEND_CRC -> SEND_WAIT_ACK -> ACK(seq) -> SEND_IDLE (next queued frame)
+// The CRC is added up chunk by chunk as the payload goes out. A frame that
+// isn't ACKed in time costs a keyframe; only a few in a row restart the handshake.
+void WifiDisplay::espSendPoll() {
+  static uint32_t sendCrcValue = 0;
+
+  switch (sendState) {
+  case SEND_IDLE: {
+    if (!framePending || !espReady) return;
+
+    uint8_t type = (pendingType == FRAME_TYPE_TIL || pendingType == FRAME_TYPE_CMD) ? MSG_DELTA : MSG_KEYFRAME;
+    uint32_t len = pendingSize + 1; // codec byte
+    sendSeq = txSeq++;
+    sendStartUs = micros();
+    sendHeader[0] = LINK_SYNC0;
+    sendHeader[1] = LINK_SYNC1;
+    sendHeader[2] = type;
+    sendHeader[3] = sendSeq & 0xFF;
+    sendHeader[4] = sendSeq >> 8;
+    sendHeader[5] = len & 0xFF;
+    sendHeader[6] = (len >> 8) & 0xFF;
+    sendHeader[7] = (len >> 16) & 0xFF;
+    sendHeader[8] = (len >> 24) & 0xFF;
+    sendHeader[9] = pendingType;
+    sendCrcValue = mz_crc32(MZ_CRC32_INIT, sendHeader + 2, sizeof(sendHeader) - 2);
+
+    sendBuffer = pendingBuffer;
+    sendSize = pendingSize;
+    sendPos = 0;
+    framePending = false;
+    sendTime = millis();
+    sendState = SEND_HEADER;
+  } // fall through
+
+  case SEND_HEADER:
+    if ((size_t)SERIAL_ESP.availableForWrite() < sizeof(sendHeader)) {
+      if (millis() - sendTime > SEND_ACK_TIMEOUT_MS) abortSend("ESP32 not reading. Aborting transfer.");
+      return;
+    }
+    SERIAL_ESP.write(sendHeader, sizeof(sendHeader));
+    sendTime = millis();
+    sendState = SEND_PAYLOAD;
+  // fall through
+
+  case SEND_PAYLOAD: {
+    // --- Send Payload in 64-byte Chunks while the USB buffer has room ---
+    const size_t packetSize = 64;
+    while (sendPos < sendSize) {
+      size_t chunkSize = min(packetSize, sendSize - sendPos);
+      if ((size_t)SERIAL_ESP.availableForWrite() < chunkSize) break;
+      size_t sent = SERIAL_ESP.write(sendBuffer + sendPos, chunkSize);
+      if (sent == 0) break;
+      sendCrcValue = mz_crc32(sendCrcValue, sendBuffer + sendPos, sent);
+      sendPos += sent;
+      sendTime = millis();
+    }
+
+    if (sendPos < sendSize) {
+      if (millis() - sendTime > SEND_ACK_TIMEOUT_MS) abortSend("ESP32 payload stalled. Aborting transfer.");
+      return;
+    }
+    sendCrc[0] = sendCrcValue & 0xFF;
+    sendCrc[1] = (sendCrcValue >> 8) & 0xFF;
+    sendCrc[2] = (sendCrcValue >> 16) & 0xFF;
+    sendCrc[3] = (sendCrcValue >> 24) & 0xFF;
+    sendState = SEND_CRC;
+  } // fall through
+
+  case SEND_CRC:
+    if ((size_t)SERIAL_ESP.availableForWrite() < LINK_CRC_SIZE) {
+      if (millis() - sendTime > SEND_ACK_TIMEOUT_MS) abortSend("ESP32 CRC stalled. Aborting transfer.");
+      return;
+    }
+    SERIAL_ESP.write(sendCrc, LINK_CRC_SIZE);
+    //SERIAL_DEBUG.printf("Sent %u bytes\n", sendSize);
+    sendTime = millis();
+    sendState = SEND_WAIT_ACK;
+  break;
+
+  case SEND_WAIT_ACK:
+    // the ACK itself comes in through espPoll()
+    if (millis() - sendTime > SEND_ACK_TIMEOUT_MS) {
+      abortSend("ESP32 frame ACK timeout. Sending a keyframe.");
+      if (++sendTimeouts >= SEND_TIMEOUTS_MAX) {
+        SERIAL_DEBUG.println("ESP32 not answering, restarting handshake");
+        sendTimeouts = 0;
+        resetLink();
+      }
+    }
+  break;
+  }
 }
 
 // ==================== Save Buffer to SD Card ====================
+// The capture buffer always holds the whole screen as shown, it is copied
+// and the sdWriter task writes the copy (see SdWriter.h)
 void WifiDisplay::saveBufferToSD(const char *screenName) {
   // Build the file name based on the screen name
   char fileName[64];
   snprintf(fileName, sizeof(fileName), "/tft_%s_log.bin", screenName);
 
-  // Remove the file if it already exists
-  if (SD.exists(fileName)) {
-    SD.remove(fileName); // Delete the file to ensure it's completely erased
-  }
-
-  // Open the file for writing (overwrite existing file)
-  File logFile = SD.open(fileName, (uint8_t)(O_WRITE | O_CREAT));
-  if (logFile) {
-    // logFile.write(uncompressedBuffer, UNCOMPRESSED_BUFFER_SIZE);
-    SERIAL_DEBUG.print("File size: ");
-    SERIAL_DEBUG.println(logFile.size());
-    logFile.close();
-    SERIAL_DEBUG.print("Buffer saved to SD card as: ");
+  if (!sdWriter.saveScreen(fileName, captureBuffer, UNCOMPRESSED_BUFFER_SIZE)) {
+    SERIAL_DEBUG.print("Previous capture still being written, skipped: ");
     SERIAL_DEBUG.println(fileName);
-  } else {
-    SERIAL_DEBUG.println("Failed to open file for writing.");
   }
-  // Clear the buffer (Overwrite with zeros)
-  memset(uncompressedBuffer, 0, UNCOMPRESSED_BUFFER_SIZE);
 }
 
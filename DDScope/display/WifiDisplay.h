@@ -5,6 +5,8 @@
 #ifndef _WIFI_SCREEN
 #define _WIFI_SCREEN
 
+#include "FrameTypes.h"
+
 #define SCREEN_WIDTH 320
 #define SCREEN_HEIGHT 480
 #define COLOR_DEPTH 2 // 2 bytes per pixel (RGB565)
@@ -12,8 +14,90 @@
 #define UNCOMPRESSED_BUFFER_SIZE ((SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH))
 #define COMPRESSED_BUFFER_SIZE ((SCREEN_WIDTH * SCREEN_HEIGHT * COLOR_DEPTH))
 
-extern uint8_t compressedBuffer[COMPRESSED_BUFFER_SIZE];
-extern uint8_t uncompressedBuffer[UNCOMPRESSED_BUFFER_SIZE];
+// Tile delta frames
+#define TILE_SIZE            16
+#define TILE_COLS            (SCREEN_WIDTH / TILE_SIZE)
+#define TILE_ROWS            (SCREEN_HEIGHT / TILE_SIZE)
+#define TILE_COUNT           (TILE_COLS * TILE_ROWS)
+#define TILE_DELTA_MAX       (TILE_COUNT / 2) // more changed tiles than this, send a full frame
+#define TILE_KEYFRAME_FRAMES 30               // full frame at least this often
+
+// Framed link to the ESP32-S3, see WifiHandController.md
+// [0xA5 0x5A][type u8][seq u16 LE][len u32 LE][payload][crc32 LE of type..payload]
+#define LINK_SYNC0           0xA5
+#define LINK_SYNC1           0x5A
+#define LINK_HEADER_SIZE     9    // sync, type, seq, len
+#define LINK_CRC_SIZE        4
+#define LINK_RX_PAYLOAD_MAX  64   // nothing the ESP sends is longer, an IP address at most
+#define LINK_RX_TIMEOUT_MS   100  // a started message that stops coming is dropped
+// Event driven frame push, see pushPoll()
+#define MIRROR_MAX_FPS       10   // frames per second at most
+#define MIRROR_SETTLE_MS     30   // quiet time after the last drawing before a frame is taken
+#define MIRROR_DRAWING_MAX_MS 500 // a screen draw that never said it finished is taken anyway
+
+// Adaptive codec selection, see chooseCodec()
+#define CODEC_EXPLORE_FRAMES 16    // keyframes between re-measuring a codec that isn't used
+#define CODEC_STATS_WEIGHT   0.25f // of a new sample in the running averages
+#define FILL_RUNS_PER_PIXEL  32    // fewer color changes than 1 in this many pixels is a fill screen
+
+typedef enum {
+  CODEC_RAW,
+  CODEC_RLE,
+  CODEC_DEF_FAST,  // deflate level 1
+  CODEC_DEF,       // deflate default level
+  CODEC_PAL,       // palette indices and RGB565 tiles, deflated
+  CODEC_TILES,     // deltas, measured but not chosen
+  CODEC_CMDS,      // draw command deltas, measured but not chosen
+  CODEC_COUNT
+} MirrorCodec;
+
+// Palette frames, see compressPalette()
+#define PAL_COLORS_MAX       256
+#define PAL_HASH_SLOTS       512  // power of two, at most half full
+#define PAL_TILE_CHANGES_MAX 64   // more color changes in a tile than this is a picture
+
+typedef enum {
+  FRAME_CLASS_FILL,    // mostly flat fills and buttons
+  FRAME_CLASS_DETAIL,  // text, catalog lists, charts
+  FRAME_CLASSES
+} FrameClass;
+
+typedef struct CodecStats {
+  uint32_t frames;
+  float    compressUs;  // running averages
+  float    bytes;
+  uint32_t lastUsed;    // keyframe count when last measured
+} CodecStats;
+
+#define SEND_ACK_TIMEOUT_MS  2000 // frame ACK or payload progress, else a keyframe is sent instead
+#define SEND_TIMEOUTS_MAX    3    // timeouts in a row before the handshake starts over
+#define TOUCH_QUEUE_SIZE     8
+
+typedef enum {
+  MSG_HELLO        = 0x01, // T->E  Teensy is alive
+  MSG_HELLO_ACK    = 0x02, // E->T  ESP heard HELLO
+  MSG_IP_REQUEST   = 0x03, // T->E  send the IP address
+  MSG_IP           = 0x04, // E->T  IP address text, also when the web client went away
+  MSG_CLIENT       = 0x05, // E->T  web client connected
+  MSG_ACK          = 0x06, // both  payload is the seq u16 of the message acknowledged
+  MSG_RESYNC       = 0x07, // E->T  frame lost or bad, send a keyframe
+  MSG_TOUCH        = 0x08, // E->T  x u16, y u16 in TFT pixels
+  MSG_RESET        = 0x09, // E->T  start the handshake over
+  MSG_KEYFRAME     = 0x10, // T->E  [codec][full frame], codec FRAME_TYPE_RAW/RLE/DEF/PAL
+  MSG_DELTA        = 0x11  // T->E  [codec][changes], codec FRAME_TYPE_TIL/CMD
+} LinkMessage;
+
+typedef enum {
+  SEND_IDLE,
+  SEND_HEADER,
+  SEND_PAYLOAD,
+  SEND_CRC,
+  SEND_WAIT_ACK
+} FrameSendState;
+
+extern uint8_t *compressedBuffer;
+extern uint8_t *uncompressedBuffer; // last finished frame
+extern uint8_t *captureBuffer;      // frame being drawn
 
 //======================================================================
 class WifiDisplay  
@@ -21,17 +105,94 @@ class WifiDisplay
   public:
     void saveBufferToSD(const char* screenName);
     void enableScreenCapture(bool enable);
-    void sendFrameToEsp(uint8_t frameType);
+    void sendFrameToEsp(uint8_t frameType);  // screen finished drawing, send it soon
+    void pushPoll();
     size_t compressWithRLE();
-    size_t compressWithDeflate();
+    size_t compressWithDeflate(int level);
+    size_t compressPalette(int level);
     //void displayIpAddress();
     void espPoll();
+    void espSendPoll();
+    bool getTouch(uint16_t &x, uint16_t &y); // next touch from the web page, false if none
     void captureSetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+    void markDirty(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
     bool isScreenCaptureEnabled = false;
     bool isUpdateScreenCaptureEnabled = false;
+    bool frameDirty = true; // something was drawn (captured) since the last frame was sent
+
+    // codec statistics for the status screen
+    const CodecStats& codecStats(uint8_t frameClass, uint8_t codec) { return stats[frameClass][codec]; }
+    uint8_t codecChoice(uint8_t frameClass) { return chosen[frameClass]; }
+    float linkBytesPerMs() { return linkRate; }
 
  private:
-  
+    void takeFrame(uint8_t frameType);
+    bool drawing = false;             // between enableScreenCapture(true) and (false)
+    bool pushRequested = false;
+    uint8_t pushType = FRAME_TYPE_DEF;
+    unsigned long lastDrawMs = 0;
+    unsigned long lastPushMs = 0;
+    bool recordBackedUp = false;      // the session recording's ring was full at the last poll
+
+    void swapCaptureBuffers();
+    uint32_t dirtyTiles[(TILE_COUNT + 31) / 32] = {0}; // drawn since the last swap
+
+    uint16_t findChangedTiles();
+    size_t compressTiles(uint16_t tileCount, int level);
+    size_t compressCommands(uint16_t pixelTiles, int level);
+    bool cmdBaseValid = false;        // the client shows the frame the recorded commands start from
+
+    uint8_t classifyFrame();
+    uint8_t chooseCodec(uint8_t frameClass);
+    void recordCodec(uint8_t frameClass, uint8_t codec, uint32_t us, size_t bytes);
+    CodecStats stats[FRAME_CLASSES][CODEC_COUNT] = {};
+    uint8_t chosen[FRAME_CLASSES] = {CODEC_DEF, CODEC_DEF}; // cheapest keyframe codec
+    bool deflateFast[FRAME_CLASSES] = {false, false};        // level 1 beat the default level, for PAL and deltas
+    uint32_t keyframes = 0;
+    float linkRate = 1000.0f;         // bytes/ms incl. the ESP ACK, USB full speed to start with
+    uint32_t sendStartUs = 0;
+
+    bool keyframeDue = true;          // client needs a full frame
+    uint16_t framesSinceKeyframe = 0;
+
+    void abortSend(const char *reason);
+    void resetLink();
+
+    // messages to the ESP
+    uint16_t txSeq = 0;
+    void sendMessage(uint8_t type, const uint8_t *payload, uint16_t len);
+    void sendAck(uint16_t seq);
+
+    // message from the ESP being received
+    uint8_t rxBuf[LINK_HEADER_SIZE + LINK_RX_PAYLOAD_MAX + LINK_CRC_SIZE];
+    uint16_t rxLen = 0;
+    unsigned long rxTime = 0;
+    void receiveByte(uint8_t c);
+    void handleMessage(uint8_t type, uint16_t seq, const uint8_t *payload, uint32_t len);
+    void showIp(const uint8_t *text, uint32_t len);
+
+    // touches from the web page, filled by espPoll, emptied by the touch task
+    uint16_t touchX[TOUCH_QUEUE_SIZE];
+    uint16_t touchY[TOUCH_QUEUE_SIZE];
+    volatile uint8_t touchHead = 0;
+    volatile uint8_t touchTail = 0;
+
+    // frame being sent
+    FrameSendState sendState = SEND_IDLE;
+    uint8_t sendHeader[LINK_HEADER_SIZE + 1]; // with the codec byte
+    uint8_t sendCrc[LINK_CRC_SIZE];
+    uint16_t sendSeq = 0;
+    const uint8_t *sendBuffer = nullptr;
+    size_t sendSize = 0;
+    size_t sendPos = 0;
+    unsigned long sendTime = 0;       // last progress, for the timeouts
+    uint8_t sendTimeouts = 0;         // in a row
+
+    // compressed frame waiting for the sender
+    bool framePending = false;
+    uint8_t pendingType = 0;
+    const uint8_t *pendingBuffer = nullptr;
+    size_t pendingSize = 0;
 };
 
 //extern WifiDisplay wifiDisplay;
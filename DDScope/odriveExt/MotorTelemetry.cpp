@@ -0,0 +1,34 @@
+// =====================================================
+// MotorTelemetry.cpp
+//
+// High rate ODrive motor telemetry in PSRAM
+
+#include "../display/Display.h"
+#include "MotorTelemetry.h"
+#include "ODriveExt.h"
+#include "src/lib/axis/motor/oDrive/ODrive.h"
+
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+
+EXTMEM static MotorSample ring[MOTOR_TELEMETRY_SAMPLES];
+
+void MotorTelemetry::sample() {
+  MotorSample& s = ring[samples % MOTOR_TELEMETRY_SAMPLES];
+  s.ms = millis();
+  for (int axis = 0; axis < 2; axis++) {
+    s.posError[axis] = oDriveExt.getMotorTargetTurns(axis) - _oDriveDriver->GetPosition(axis);
+    s.Iq[axis] = _oDriveDriver->GetIqMeasured(axis);
+    s.velocity[axis] = _oDriveDriver->GetVelocity(axis);
+  }
+  samples++;
+}
+
+bool MotorTelemetry::get(uint32_t index, MotorSample& s) {
+  if (index >= samples || samples - index > MOTOR_TELEMETRY_SAMPLES) return false;
+  s = ring[index % MOTOR_TELEMETRY_SAMPLES];
+  return true;
+}
+
+MotorTelemetry motorTelemetry;
+
+#endif
@@ -0,0 +1,43 @@
+// =====================================================
+// MotorTelemetry.h
+// High rate ODrive motor telemetry in PSRAM
+//
+// A task samples position error, Iq and velocity of both motors out of the
+// CAN telemetry cache into a ring buffer. When the ODrive broadcasts encoder
+// estimates and Iq the samples cost no bus traffic. ODriveScreen plots them
+// as a strip chart.
+
+#ifndef MOTOR_TELEMETRY_H
+#define MOTOR_TELEMETRY_H
+
+#include <Arduino.h>
+
+#define MOTOR_TELEMETRY_MS         10  // sample period, 100 Hz
+#define MOTOR_TELEMETRY_SAMPLES  8192  // about 80 s of history, 224KB
+
+// By ODrive axis number, ALT_MOTOR or AZM_MOTOR
+typedef struct MotorSample {
+  uint32_t ms;
+  float    posError[2];   // OnStep target - encoder position, turns
+  float    Iq[2];         // amps
+  float    velocity[2];   // turns/s
+} MotorSample;
+
+class MotorTelemetry {
+  public:
+    // Task, one sample of both motors
+    void sample();
+
+    // Samples taken since boot, index of the next one
+    uint32_t count() { return samples; }
+
+    // Sample number index, false if it isn't taken yet or was overwritten
+    bool get(uint32_t index, MotorSample& s);
+
+  private:
+    uint32_t samples = 0;
+};
+
+extern MotorTelemetry motorTelemetry;
+
+#endif
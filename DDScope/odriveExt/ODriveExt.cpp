@@ -9,6 +9,7 @@
 
 #include "../display/Display.h"
 #include "ODriveExt.h"
+#include "ODriveUart.h"
 #include "src/lib/axis/motor/oDrive/ODrive.h"
 #include "../../../telescope/mount/Mount.h"
 #include "../../../lib/tasks/OnTask.h"
@@ -79,7 +80,11 @@ float ODriveExt::getODriveBusVoltage(int axis) {
   #elif ODRIVE_COMM_MODE == OD_CAN
     float battery_voltage = _oDriveDriver->GetVbusVoltage(axis);  //Can be sent to either axis
   #endif
+  return batteryStatus(battery_voltage);
+}
 
+// Battery LED and status from the bus voltage
+float ODriveExt::batteryStatus(float battery_voltage) {
   // Handle timeout condition:
   // ----Post Note: seems that even when ODrive is off that CAN returns something once a 
   // ----shorter timeout of 10 msec was included in the sendMessage so the following is commented out.
@@ -161,6 +166,93 @@ uint8_t ODriveExt::getODriveCurrentState(int axis) {
   return cState;
 }
 
+// ================ Snapshot ======================
+// On CAN the positions, Iq, state and the error flags come out of the broadcast
+// cache without bus traffic, motor and encoder error words are only asked for
+// when the heartbeat flags say there is one, and vbus is one request.
+// On UART all the reads are pipelined, one round trip for the lot.
+const ODriveSnapshot& ODriveExt::snapshot() {
+  unsigned long now = millis();
+  if (snapTaken && now - snap.ms < ODRIVE_SNAPSHOT_MS) return snap;
+
+  snap.ms = now;
+  snap.valid = !oDriveRXoff;
+  snapTaken = true;
+  if (!snap.valid) {
+    // the thermistors are read by the Teensy, not the ODrive
+    snap.axis[ALT_MOTOR].temperature = getMotorTemp(ALT_MOTOR);
+    snap.axis[AZM_MOTOR].temperature = getMotorTemp(AZM_MOTOR);
+    return snap;
+  }
+
+  #if ODRIVE_COMM_MODE == OD_UART
+    oDriveUart.read("vbus_voltage", &snap.vbus);
+  #elif ODRIVE_COMM_MODE == OD_CAN
+    snap.vbus = _oDriveDriver->GetVbusVoltage(AZM_MOTOR);
+  #endif
+  readAxis(ALT_MOTOR, snap.axis[ALT_MOTOR]);
+  readAxis(AZM_MOTOR, snap.axis[AZM_MOTOR]);
+  #if ODRIVE_COMM_MODE == OD_UART
+    snap.valid = oDriveUart.wait();
+    snap.axis[ALT_MOTOR].state = uartState[ALT_MOTOR];
+    snap.axis[AZM_MOTOR].state = uartState[AZM_MOTOR];
+  #endif
+  if (snap.valid) batteryStatus(snap.vbus); // vbus is stale if a read failed
+  return snap;
+}
+
+#if ODRIVE_COMM_MODE == OD_UART
+// Queue a read of axis<axis>.<property>
+static void readAxisProperty(int axis, const char* property, float* dest) {
+  char path[OD_UART_PROPERTY];
+  snprintf(path, sizeof(path), "axis%d.%s", axis, property);
+  oDriveUart.read(path, dest);
+}
+
+static void readAxisProperty(int axis, const char* property, int32_t* dest) {
+  char path[OD_UART_PROPERTY];
+  snprintf(path, sizeof(path), "axis%d.%s", axis, property);
+  oDriveUart.read(path, dest);
+}
+#endif
+
+// On UART this only queues the reads, snapshot() waits for them
+void ODriveExt::readAxis(int axis, ODriveAxisSnapshot& a) {
+  #if ODRIVE_COMM_MODE == OD_UART
+    readAxisProperty(axis, "encoder.pos_estimate", &a.position);
+    readAxisProperty(axis, "encoder.vel_estimate", &a.velocity);
+    readAxisProperty(axis, "motor.I_bus", &a.Iq);
+    readAxisProperty(axis, "current_state", &uartState[axis]);
+    readAxisProperty(axis, "error", (int32_t*)&a.axisError);
+    readAxisProperty(axis, "motor.error", (int32_t*)&a.motorError);
+    readAxisProperty(axis, "encoder.error", (int32_t*)&a.encoderError);
+    readAxisProperty(axis, "controller.error", (int32_t*)&a.controllerFlags);
+  #elif ODRIVE_COMM_MODE == OD_CAN
+    a.position = _oDriveDriver->GetPosition(axis);
+    a.velocity = _oDriveDriver->GetVelocity(axis);
+    a.Iq = _oDriveDriver->GetIqMeasured(axis);
+    a.state = _oDriveDriver->GetCurrentState(axis);
+    a.axisError = _oDriveDriver->GetAxisError(axis);
+    a.motorError = _oDriveDriver->GetMotorFlags(axis) ? _oDriveDriver->GetMotorError(axis) : 0;
+    a.encoderError = _oDriveDriver->GetEncoderFlags(axis) ? _oDriveDriver->GetEncoderError(axis) : 0;
+    a.controllerFlags = _oDriveDriver->GetControllerFlags(axis);
+  #endif
+  a.temperature = getMotorTemp(axis);
+}
+
+// OnStep target of ODrive axis in turns
+float ODriveExt::getMotorTargetTurns(int axis) {
+  double currentTarget = 0.0000;
+  if (ODRIVE_SWAP_AXES == ON) {
+    if (axis == ALT_MOTOR) currentTarget = axis2.getTargetCoordinate();
+    if (axis == AZM_MOTOR) currentTarget = axis1.getTargetCoordinate();
+  } else {
+    if (axis == ALT_MOTOR) currentTarget = axis1.getTargetCoordinate();
+    if (axis == AZM_MOTOR) currentTarget = axis2.getTargetCoordinate();
+  }
+  return ((float)currentTarget*RAD_DEG_RATIO)/360;
+}
+
 // Get the difference between ODrive setpoint and the encoder
 float ODriveExt::getMotorPositionDelta(int axis) {
   
@@ -171,22 +263,14 @@ float ODriveExt::getMotorPositionDelta(int axis) {
     float posEst = _oDriveDriver->readFloat(); 
     float deltaPos = fabs(reqPos - posEst);
   #elif ODRIVE_COMM_MODE == OD_CAN
-    double currentTarget = 0.0000;
     float target = 0.0000;
     float actual = 0.0000;
     float deltaPos = 0.0000;
-    if (ODRIVE_SWAP_AXES == ON) {
-      if (axis == ALT_MOTOR) currentTarget = axis2.getTargetCoordinate();
-      if (axis == AZM_MOTOR) currentTarget = axis1.getTargetCoordinate();
-    } else {
-      if (axis == ALT_MOTOR) currentTarget = axis1.getTargetCoordinate();
-      if (axis == AZM_MOTOR) currentTarget = axis2.getTargetCoordinate();
-    }
     // the following variables are in fractional "turns"
-    target = ((float)currentTarget*RAD_DEG_RATIO)/360;
+    target = getMotorTargetTurns(axis);
     //int32_t enc_actual = _oDriveDriver->GetEncoderShadowCount(axis); // 2^14 = 16384 counts per revolution
     //actual = (float)enc_actual/16384;
-    actual = _oDriveDriver->GetPosition(axis);
+    actual = snapshot().axis[axis].position;
     deltaPos = (target - actual); 
     //char deltaPosS[9]="";
     //char actualS[9]="";
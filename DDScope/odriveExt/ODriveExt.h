@@ -21,6 +21,8 @@
 #define ALT_VEL_INT_GAIN_DEF  0.4 // do not change unless changed in ODrive setup, default value
 #define ALT_VEL_INT_GAIN_HI   0.2 // 0.7
 
+#define ODRIVE_SNAPSHOT_MS     50 // callers within this long of each other share one snapshot
+
 enum Component
 {
   COMP_FIRST,
@@ -32,8 +34,32 @@ enum Component
   COMP_LAST
 };
 
+// Everything the screens show about one ODrive axis
+typedef struct ODriveAxisSnapshot {
+  float    position;        // turns
+  float    velocity;        // turns/s
+  float    Iq;              // amps, Iq measured on CAN, motor.I_bus on UART as getMotorCurrent()
+  uint8_t  state;
+  uint32_t axisError;
+  uint32_t motorError;
+  uint32_t encoderError;
+  uint32_t controllerFlags; // controller.error on UART, the heartbeat flags byte on CAN
+                            // (non-zero on error, CAN Simple can't request the error bits)
+  float    temperature;     // motor, deg F
+} ODriveAxisSnapshot;
+
+typedef struct ODriveSnapshot {
+  unsigned long ms;         // millis() when taken
+  bool     valid;           // false if the ODrive isn't answering
+  float    vbus;
+  ODriveAxisSnapshot axis[2]; // by ODrive axis number, ALT_MOTOR or AZM_MOTOR
+} ODriveSnapshot;
+
 class ODriveExt {
   public:
+    // State of both axes with the fewest bus transactions, shared by all
+    // callers within ODRIVE_SNAPSHOT_MS
+    const ODriveSnapshot& snapshot();
     
     // getters
     int getMotorPositionCounts(int axis);
@@ -42,6 +68,7 @@ class ODriveExt {
     float getEncoderPositionDeg(int axis);
     float getMotorPositionTurns(int axis);
     float getMotorPositionDelta(int axis);
+    float getMotorTargetTurns(int axis);
     float getMotorCurrent(int axis);
     float getMotorTemp(int axis);
     float getODriveVelGain(int axis);
@@ -71,6 +98,13 @@ class ODriveExt {
     bool ALTgainDefault;
     
   private:
+    void readAxis(int axis, ODriveAxisSnapshot& a);
+    float batteryStatus(float battery_voltage);
+
+    ODriveSnapshot snap = {};
+    bool snapTaken = false;
+    int32_t uartState[2] = {0, 0};
+
     bool batLowLED = false;
     bool oDriveRXoff = false;
 };
@@ -0,0 +1,100 @@
+// =====================================================
+// ODriveUart.cpp
+//
+// Pipelined ASCII protocol client for the ODrive UART
+
+#include "../display/Display.h"
+#include "ODriveUart.h"
+
+#if ODRIVE_COMM_MODE == OD_UART
+
+bool ODriveUart::queue(const char* property, float* floatDest, int32_t* intDest) {
+  if (count == OD_UART_QUEUE || strlen(property) >= OD_UART_PROPERTY) return false;
+  Request& r = requests[(head + count) % OD_UART_QUEUE];
+  strcpy(r.property, property);
+  r.floatDest = floatDest;
+  r.intDest = intDest;
+  count++;
+  return true;
+}
+
+bool ODriveUart::read(const char* property, float* dest) {
+  return queue(property, dest, NULL);
+}
+
+bool ODriveUart::read(const char* property, int32_t* dest) {
+  return queue(property, NULL, dest);
+}
+
+// Finish the oldest read with the reply in line
+void ODriveUart::complete(bool ok) {
+  Request& r = requests[head];
+  char* end = line;
+  float value = ok ? strtof(line, &end) : 0.0F;
+  if (end == line) ok = false; // "invalid property" and the like
+
+  if (ok) {
+    if (r.floatDest) *r.floatDest = value;
+    if (r.intDest) *r.intDest = (int32_t)strtoul(line, NULL, 10); // error words use all 32 bits
+  } else {
+    failed = true;
+    VF("MSG: ODrive UART, no reply to "); VL(r.property);
+  }
+
+  head = (head + 1) % OD_UART_QUEUE;
+  count--;
+  sent--;
+  sentMs = millis();
+}
+
+// A reply that never came would pair every later reply with the wrong read,
+// so fail all reads in flight and drop whatever arrives late
+void ODriveUart::flush() {
+  while (sent) complete(false);
+  delay(2);
+  while (ODRIVE_SERIAL.available()) ODRIVE_SERIAL.read();
+  lineLen = 0;
+}
+
+// Send queued reads and parse replies, never blocks
+void ODriveUart::poll() {
+  while (ODRIVE_SERIAL.available()) {
+    char c = ODRIVE_SERIAL.read();
+    if (c == '\r') continue;
+    if (c != '\n') {
+      if (lineLen < OD_UART_LINE - 1) line[lineLen++] = c;
+      continue;
+    }
+    line[lineLen] = 0;
+    lineLen = 0;
+    if (sent) complete(true); // nothing asked for it otherwise
+  }
+
+  if (sent && millis() - sentMs > OD_UART_TIMEOUT_MS) flush();
+
+  while (sent < count && sent < OD_UART_PIPELINE) {
+    if (sent == 0) sentMs = millis();
+    ODRIVE_SERIAL.print("r ");
+    ODRIVE_SERIAL.print(requests[(head + sent) % OD_UART_QUEUE].property);
+    ODRIVE_SERIAL.print('\n');
+    sent++;
+  }
+}
+
+bool ODriveUart::wait(uint32_t timeoutMs) {
+  unsigned long start = millis();
+  while (count && millis() - start < timeoutMs) poll();
+  bool ok = count == 0 && !failed;
+  if (count) {
+    flush();
+    VF("MSG: ODrive UART, dropped "); V(count); VLF(" reads");
+    head = (head + count) % OD_UART_QUEUE;
+    count = 0;
+  }
+  failed = false;
+  return ok;
+}
+
+ODriveUart oDriveUart;
+
+#endif
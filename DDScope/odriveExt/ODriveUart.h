@@ -0,0 +1,69 @@
+// =====================================================
+// ODriveUart.h
+// Pipelined ASCII protocol client for ODRIVE_COMM_MODE == OD_UART
+//
+// Every "r <property>" line gets exactly one reply line and the ODrive answers
+// them in order. Reads are queued and then run as one batch by wait(): they are
+// written back to back and the replies are matched to the oldest read still in
+// flight, so reading several properties costs one link round trip instead of
+// one each. wait() blocks like the ODriveArduino reads that share the serial
+// port, nothing touches the port between batches.
+//
+// There is no non-blocking mode with completion callbacks. Polling from a task
+// would let an ODriveArduino read land between a batch's replies and take one
+// of them, every request would need its own storage instead of a dest on the
+// caller's stack, and the getters and snapshot() return their values at once
+// anyway, so a callback would only end up waited on.
+
+#ifndef ODRIVE_UART_H
+#define ODRIVE_UART_H
+
+#include <Arduino.h>
+
+#define OD_UART_QUEUE         24  // reads queued or in flight
+#define OD_UART_PIPELINE       8  // reads in flight at once, keeps the ODrive RX buffer from overflowing
+#define OD_UART_PROPERTY      48
+#define OD_UART_LINE          32
+#define OD_UART_TIMEOUT_MS   100  // per reply, then the pipeline is flushed
+
+class ODriveUart {
+  public:
+    // Queue a read of property, e.g. "axis0.encoder.pos_estimate", for the next
+    // wait(). *dest is left alone if the read fails. False if the queue is full.
+    bool read(const char* property, float* dest);
+    bool read(const char* property, int32_t* dest);
+
+    // Run the queued reads until every one is answered, false if any failed.
+    // Doesn't yield, so no other task can put a blocking read between the
+    // replies. Reads still queued at timeoutMs are dropped, none outlive the
+    // call, so dest may point to the caller's stack.
+    bool wait(uint32_t timeoutMs = OD_UART_TIMEOUT_MS*OD_UART_QUEUE);
+
+    bool isIdle() { return count == 0; }
+
+  private:
+    struct Request {
+      char          property[OD_UART_PROPERTY];
+      float*        floatDest;
+      int32_t*      intDest;
+    };
+
+    bool queue(const char* property, float* floatDest, int32_t* intDest);
+    void poll();
+    void complete(bool ok);
+    void flush();
+
+    Request  requests[OD_UART_QUEUE];
+    uint8_t  head = 0;              // oldest, the next reply belongs to it if it was sent
+    uint8_t  count = 0;
+    uint8_t  sent = 0;              // from head
+    bool     failed = false;        // in this wait()
+    unsigned long sentMs = 0;       // the head was sent or the last reply came
+
+    char     line[OD_UART_LINE];
+    uint8_t  lineLen = 0;
+};
+
+extern ODriveUart oDriveUart;
+
+#endif
@@ -80,15 +80,59 @@
 #define AS_ABT_BOXSIZE_W    BIG_BOX_W
 #define AS_ABT_BOXSIZE_H    BIG_BOX_H 
 
+// Guide buttons, arranged around a center point
+#define AG_CENTER_X         (TFTWIDTH/2 + 50)
+#define AG_CENTER_Y         (TFTHEIGHT/2 + 30)
+#define AG_BOXSIZE_W        60
+#define AG_BOXSIZE_H        40
+#define AG_SPACER           4
+#define AG_RIGHT_X          (AG_CENTER_X + AG_BOXSIZE_W/2 + AG_SPACER)
+#define AG_LEFT_X           (AG_CENTER_X - AG_BOXSIZE_W/2 - AG_BOXSIZE_W - AG_SPACER)
+#define AG_UP_X             (AG_CENTER_X - AG_BOXSIZE_W/2)
+#define AG_DOWN_X           AG_UP_X
+#define AG_RIGHT_Y          (AG_CENTER_Y - AG_BOXSIZE_H/2)
+#define AG_LEFT_Y           AG_RIGHT_Y
+#define AG_UP_Y             (AG_CENTER_Y - AG_BOXSIZE_H - AG_SPACER)
+#define AG_DOWN_Y           (AG_CENTER_Y + AG_SPACER)
+
 AlignStates Current_State = Idle_State;
 AlignStates Next_State = Idle_State;
 
 // Align Button object
-Button alignButton(0,0,0,0, butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+Button alignButton(0,0,0,0, &butOnBackground, &butBackground, &butOutline, mainFontWidth, mainFontHeight, "");
 
 // Canvas Print object Custom Font
 CanvasPrint canvAlignInsPrint(&Inconsolata_Bold8pt7b);
 
+// Align Screen layout
+static const UIStyle alignStyles[] = {
+  { &alignButton, &Inconsolata_Bold8pt7b, &canvAlignInsPrint },
+};
+
+enum {
+  AL_HOME, AL_STARS_2, AL_STARS_3, AL_STARS_4, AL_CATALOG, AL_GOTO, AL_SYNC, AL_SAVE, AL_START, AL_ABORT,
+  AL_EAST, AL_WEST, AL_NORTH, AL_SOUTH, AL_GUIDE_RATE_LABEL, AL_GUIDE_RATE, AL_COUNT
+};
+static const UIElement alignElements[AL_COUNT] = {
+  { AL_HOME,             UI_BUTTON, 0, HOME_X,                      HOME_Y,        HOME_BOXSIZE_W,   HOME_BOXSIZE_H,   "Go Home ",  "Slewing" },
+  { AL_STARS_2,          UI_BUTTON, 0, NUM_S_X,                     NUM_S_Y,       NUM_S_BOXSIZE_W,  NUM_S_BOXSIZE_H,  "2",         NULL      },
+  { AL_STARS_3,          UI_BUTTON, 0, NUM_S_X + NUM_S_SPACING_X,   NUM_S_Y,       NUM_S_BOXSIZE_W,  NUM_S_BOXSIZE_H,  "3",         NULL      },
+  { AL_STARS_4,          UI_BUTTON, 0, NUM_S_X + 2*(NUM_S_SPACING_X), NUM_S_Y,     NUM_S_BOXSIZE_W,  NUM_S_BOXSIZE_H,  "4",         NULL      },
+  { AL_CATALOG,          UI_BUTTON, 0, ALIGN_CAT_X,                 ALIGN_CAT_Y,   CAT_BOXSIZE_W,    CAT_BOXSIZE_H,    "SEL CATLG", "CATALOG" },
+  { AL_GOTO,             UI_BUTTON, 0, GOTO_X,                      GOTO_Y,        GOTO_BOXSIZE_W,   GOTO_BOXSIZE_H,   "GOTO",      "Slewing" },
+  { AL_SYNC,             UI_BUTTON, 0, ALIGN_X,                     ALIGN_Y,       ALIGN_BOXSIZE_W,  ALIGN_BOXSIZE_H,  "SYNC",      "SYNC'd"  },
+  { AL_SAVE,             UI_BUTTON, 0, WRITE_ALIGN_X,               WRITE_ALIGN_Y, SA_BOXSIZE_W,     SA_BOXSIZE_H,     "SAVE",      "Saved"   },
+  { AL_START,            UI_BUTTON, 0, START_ALIGN_X,               START_ALIGN_Y, ST_BOXSIZE_W,     ST_BOXSIZE_H,     "START",     "Running" },
+  { AL_ABORT,            UI_BUTTON, 0, AS_ABORT_X,                  AS_ABORT_Y,    AS_ABT_BOXSIZE_W, AS_ABT_BOXSIZE_H, "STOP",      "Stop'd"  },
+  { AL_EAST,             UI_BUTTON, 0, AG_RIGHT_X,                  AG_RIGHT_Y,    AG_BOXSIZE_W,     AG_BOXSIZE_H,     "EAST",      NULL      },
+  { AL_WEST,             UI_BUTTON, 0, AG_LEFT_X,                   AG_LEFT_Y,     AG_BOXSIZE_W,     AG_BOXSIZE_H,     "WEST",      NULL      },
+  { AL_NORTH,            UI_BUTTON, 0, AG_UP_X,                     AG_UP_Y,       AG_BOXSIZE_W,     AG_BOXSIZE_H,     "NORTH",     NULL      },
+  { AL_SOUTH,            UI_BUTTON, 0, AG_DOWN_X,                   AG_DOWN_Y,     AG_BOXSIZE_W,     AG_BOXSIZE_H,     "SOUTH",     NULL      },
+  { AL_GUIDE_RATE_LABEL, UI_LABEL,  0, 242,                         225,           75,               15,               "GuideRate", NULL      },
+  { AL_GUIDE_RATE,       UI_VALUE,  0, 250,                         240,           65,               15,               NULL,        NULL      },
+};
+static UILayout alignLayout(alignElements, AL_COUNT, alignStyles);
+
 // ---- Draw Alignment Page ----
 void AlignScreen::draw() {
   setCurrentScreen(ALIGN_SCREEN);
@@ -104,7 +148,7 @@ void AlignScreen::draw() {
   drawCommonStatusLabels();
   updateAlignButtons(); // draw initial buttons
 
-  canvAlignInsPrint.printLJ(242, 225, 75, 15, "GuideRate", false);
+  alignLayout.drawLabels();
   char guideRateText[10];
   switch (guide.settings.axis1RateSelect) {
     case 0:  strcpy(guideRateText, " Quarter"); break;
@@ -120,7 +164,7 @@ void AlignScreen::draw() {
     case 10: strcpy(guideRateText, " Custom "); break;
     default: strcpy(guideRateText, "  Error "); break;
   }
-  canvAlignInsPrint.printLJ(250, 240, 65, 15, guideRateText, false);
+  alignLayout.drawValue(AL_GUIDE_RATE, guideRateText, false, true);
   showCorrections();
   //showOnStepCmdErr(); // show error bar
   updateAlignStatus();
@@ -133,7 +177,7 @@ void AlignScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Align");
+  wifiDisplay.saveBufferToSD("Align");
   #endif
 }
 
@@ -200,86 +244,38 @@ bool AlignScreen::alignButStateChange() {
 ********************************************************/
 
 // *********** Update Align Buttons **************
+// Only buttons whose label or state changed since the last call are drawn again
 void AlignScreen::updateAlignButtons() {
-  int x_offset = 0;
-  
-  //showAlignStatus();
-
   // Go to Home Position
-  if (mount.isSlewing()) {
-    alignButton.draw(HOME_X, HOME_Y, HOME_BOXSIZE_W, HOME_BOXSIZE_H, "Slewing", BUT_ON);                  
-  } else {
-    alignButton.draw(HOME_X, HOME_Y, HOME_BOXSIZE_W, HOME_BOXSIZE_H, "Go Home ", BUT_OFF);
-  }
-    
+  alignLayout.drawButton(AL_HOME, mount.isSlewing());
+
   // Number of Stars for Alignment Buttons
   // Alignment become active here
-  if (numAlignStars == 2) {   
-    alignButton.draw(NUM_S_X, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "2", BUT_ON);
-  } else {
-    alignButton.draw(NUM_S_X, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "2", BUT_OFF);
-  } 
-  x_offset += NUM_S_SPACING_X;
-  if (numAlignStars == 3) {   
-    alignButton.draw(NUM_S_X+x_offset, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "3", BUT_ON);
-  } else {
-    alignButton.draw(NUM_S_X+x_offset, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "3", BUT_OFF);
-  } 
-  x_offset += NUM_S_SPACING_X;
-  if (numAlignStars == 4) {   
-    alignButton.draw(NUM_S_X+x_offset, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "4", BUT_ON);
-  } else {
-    alignButton.draw(NUM_S_X+x_offset, NUM_S_Y, NUM_S_BOXSIZE_W, NUM_S_BOXSIZE_H, "4", BUT_OFF);
-  } 
+  alignLayout.drawButton(AL_STARS_2, numAlignStars == 2);
+  alignLayout.drawButton(AL_STARS_3, numAlignStars == 3);
+  alignLayout.drawButton(AL_STARS_4, numAlignStars == 4);
 
   // go to the Star Catalog
-  if (catalogBut) {
-    alignButton.draw(ALIGN_CAT_X, ALIGN_CAT_Y, CAT_BOXSIZE_W, CAT_BOXSIZE_H, "CATALOG", BUT_ON);
-  } else {
-    alignButton.draw(ALIGN_CAT_X, ALIGN_CAT_Y, CAT_BOXSIZE_W, CAT_BOXSIZE_H, "SEL CATLG", BUT_OFF);         
-  }
+  alignLayout.drawButton(AL_CATALOG, catalogBut);
 
   // Go To Coordinates Button
-  if (gotoBut || mount.isSlewing()) {
-    alignButton.draw(GOTO_X, GOTO_Y,  GOTO_BOXSIZE_W, GOTO_BOXSIZE_H, "Slewing", BUT_ON);
-  } else {
-    alignButton.draw(GOTO_X, GOTO_Y,  GOTO_BOXSIZE_W, GOTO_BOXSIZE_H, "GOTO", BUT_OFF);
-  }
-  
-  // SYNC button; calculate alignment parameters
-  if (syncBut) {
-    alignButton.draw(ALIGN_X, ALIGN_Y, ALIGN_BOXSIZE_W, ALIGN_BOXSIZE_H, "SYNC'd", BUT_ON);
+  alignLayout.drawButton(AL_GOTO, gotoBut || mount.isSlewing());
+
+  // SYNC button, save the alignment calculations to EEPROM, and Stop
+  // Alignment flash their "done" label once
+  alignLayout.drawButton(AL_SYNC, syncBut);
+  alignLayout.drawButton(AL_SAVE, saveAlignBut);
+  alignLayout.drawButton(AL_ABORT, abortBut);
+  if (syncBut || saveAlignBut || abortBut) {
     syncBut = false;
-    display._redrawBut = true;
-  } else {
-    alignButton.draw(ALIGN_X, ALIGN_Y, ALIGN_BOXSIZE_W, ALIGN_BOXSIZE_H, "SYNC", BUT_OFF);         
-  }
-
-  // save the alignment calculations to EEPROM
-  if (saveAlignBut) {
-    alignButton.draw(WRITE_ALIGN_X, WRITE_ALIGN_Y, SA_BOXSIZE_W, SA_BOXSIZE_H, "Saved", BUT_ON);
     saveAlignBut = false;
+    abortBut = false;
     display._redrawBut = true;
-  } else {
-    alignButton.draw(WRITE_ALIGN_X, WRITE_ALIGN_Y, SA_BOXSIZE_W, SA_BOXSIZE_H, "SAVE", BUT_OFF);
   }
 
   // start alignnment
-  if (startAlignBut) {
-    alignButton.draw(START_ALIGN_X, START_ALIGN_Y, ST_BOXSIZE_W, ST_BOXSIZE_H, "Running", BUT_ON);
-  } else {
-    alignButton.draw(START_ALIGN_X, START_ALIGN_Y, ST_BOXSIZE_W, ST_BOXSIZE_H, "START", BUT_OFF);
-  }
-  
-  // Stop Alignment Button
-  if (abortBut) {
-    alignButton.draw(AS_ABORT_X, AS_ABORT_Y, AS_ABT_BOXSIZE_W, AS_ABT_BOXSIZE_H, "Stop'd", BUT_ON);
-    abortBut = false;
-    display._redrawBut = true;
-    alignButton.draw(AS_ABORT_X, AS_ABORT_Y, AS_ABT_BOXSIZE_W, AS_ABT_BOXSIZE_H, "STOP", BUT_OFF);
-  } else {
-    alignButton.draw(AS_ABORT_X, AS_ABORT_Y, AS_ABT_BOXSIZE_W, AS_ABT_BOXSIZE_H, "STOP", BUT_OFF);
-  }
+  alignLayout.drawButton(AL_START, startAlignBut);
+
   updateGuideButtons(); // draw the guide buttons
 }
 
@@ -510,180 +506,145 @@ void AlignScreen::stateMachine() {
 // -- return true if touched --
 bool AlignScreen::touchPoll(uint16_t px, uint16_t py) { 
   char reply[2];
-  // ==== ABORT GOTO  Button ====
-  if (py > AS_ABORT_Y && py < (AS_ABORT_Y + AS_ABT_BOXSIZE_H) && px > AS_ABORT_X && px < (AS_ABORT_X + AS_ABT_BOXSIZE_W)) {
-    BEEP;
-    commandBool(":Q#"); // stops move
-    digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZM LED
-    axis1.enable(false);
-    digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
-    axis2.enable(false);
-    commandBool(":Td#"); // Disable Tracking
-    char numClear[10];
-    sprintf (numClear, ":A%d#", 0); // set number of align stars
-    commandBool(numClear);
-
-    // clear all button states since not sure which was active
-    numAlignStars = 0;
-    alignCurStar = 0;
-    abortBut = true; // this should trigger the State Machine to return to Idle State
-    homeBut = false;
-    catalogBut = false;
-    gotoBut = false;
-    syncBut = false;
-    saveAlignBut = false;
-    startAlignBut = false;
-    Next_State = Idle_State;
-    return true;
-  }
+  uint8_t id = alignLayout.hitTest(px, py);
 
-  // Go to Home Telescope Requested
-  if (px > HOME_X && px < HOME_X + HOME_BOXSIZE_W && py > HOME_Y  && py < HOME_Y + HOME_BOXSIZE_H) {
-    if (Current_State==Home_State) {
-      BEEP;
-      homeBut = true;
-      return true;
-    }
-  }
-  
-  // Number of Stars for alignment
-  int x_offset = 0;
-  if (Current_State==Num_Stars_State) {
-    if (py > NUM_S_Y && py < (NUM_S_Y + NUM_S_BOXSIZE_H) && px > NUM_S_X+x_offset && px < (NUM_S_X+x_offset + NUM_S_BOXSIZE_W)) {
+  switch (id) {
+    case AL_ABORT: { // ==== ABORT GOTO  Button ====
       BEEP;
-      numAlignStars = 2;
+      commandBool(":Q#"); // stops move
+      digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZM LED
+      axis1.enable(false);
+      digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
+      axis2.enable(false);
+      commandBool(":Td#"); // Disable Tracking
+      char numClear[10];
+      sprintf (numClear, ":A%d#", 0); // set number of align stars
+      commandBool(numClear);
+
+      // clear all button states since not sure which was active
+      numAlignStars = 0;
+      alignCurStar = 0;
+      abortBut = true; // this should trigger the State Machine to return to Idle State
+      homeBut = false;
+      catalogBut = false;
+      gotoBut = false;
+      syncBut = false;
+      saveAlignBut = false;
+      startAlignBut = false;
+      Next_State = Idle_State;
       return true;
     }
-    x_offset += NUM_S_SPACING_X;
-    if (py > NUM_S_Y && py < (NUM_S_Y + NUM_S_BOXSIZE_H) && px > NUM_S_X+x_offset && px < (NUM_S_X+x_offset + NUM_S_BOXSIZE_W)) {
+
+    // The step buttons only respond in their own state
+    case AL_HOME: // Go to Home Telescope Requested
+      if (Current_State != Home_State) break;
       BEEP;
-      numAlignStars = 3;
+      homeBut = true;
       return true;
-    }
-    x_offset += NUM_S_SPACING_X;
-    if (py > NUM_S_Y && py < (NUM_S_Y + NUM_S_BOXSIZE_H) && px > NUM_S_X+x_offset && px < (NUM_S_X+x_offset + NUM_S_BOXSIZE_W)) {
+
+    case AL_STARS_2: // Number of Stars for alignment
+    case AL_STARS_3:
+    case AL_STARS_4:
+      if (Current_State != Num_Stars_State) break;
       BEEP;
-      numAlignStars = 4;
+      numAlignStars = 2 + (id - AL_STARS_2);
       return true;
-    }
-  }
 
-  // Call up the Catalog Button
-  if (py > ALIGN_CAT_Y && py < (ALIGN_CAT_Y + CAT_BOXSIZE_H) && px > ALIGN_CAT_X && px < (ALIGN_CAT_X + CAT_BOXSIZE_W)) {
-    if (Current_State==Select_Catalog_State ) {
+    case AL_CATALOG: // Call up the Catalog Button
+      if (Current_State != Select_Catalog_State) break;
       BEEP;
       catalogBut = true;
       return true;
-    }
-  }
 
-  // Go To Target Coordinates
-  if (py > GOTO_Y && py < (GOTO_Y + GOTO_BOXSIZE_H) && px > GOTO_X && px < (GOTO_X + GOTO_BOXSIZE_W)) {
-    if (Current_State==Goto_State) { 
+    case AL_GOTO: // Go To Target Coordinates
+      if (Current_State != Goto_State) break;
       BEEP;
       gotoBut = true;
       return true;
-    }
-  }
 
-  // SYNC - calculate alignment corrections Button
-  if (py > ALIGN_Y && py < (ALIGN_Y + ALIGN_BOXSIZE_H) && px > ALIGN_X && px < (ALIGN_X + ALIGN_BOXSIZE_W)) { 
-    if (Current_State==Sync_State) {
+    case AL_SYNC: // SYNC - calculate alignment corrections Button
+      if (Current_State != Sync_State) break;
       BEEP;
       syncBut = true;
       return true;
-    }
-  }
 
-  // Write Alignment Button
-  if (py > WRITE_ALIGN_Y && py < (WRITE_ALIGN_Y + SA_BOXSIZE_H) && px > WRITE_ALIGN_X && px < (WRITE_ALIGN_X + SA_BOXSIZE_W)) {
-    if (Current_State==Write_State) {
+    case AL_SAVE: // Write Alignment Button
+      if (Current_State != Write_State) break;
       BEEP;
       saveAlignBut = true;
       return true;
-    }
-  }  
-
-  // START Alignment Button - clear the corrections, reset the state machine
-  if (py > START_ALIGN_Y && py < (START_ALIGN_Y + ST_BOXSIZE_H) && px > START_ALIGN_X && px < (START_ALIGN_X + ST_BOXSIZE_W)) { 
-    BEEP;
-    startAlignBut = true;
-    alignCurStar = 0;
-    numAlignStars = 2; // number of selected align stars from buttons
-    transform.align.modelClear();
-    Current_State = Idle_State;
-
-    // Enable the Motors
-    digitalWrite(AZ_ENABLED_LED_PIN, LOW); // Turn On AZ LED
-    axis1.enable(true); // AZ motor on
-    
-    digitalWrite(ALT_ENABLED_LED_PIN, LOW); // Turn On ALT LED
-    axis2.enable(true); // ALT motor on
-    return true;
-  } 
-
-  // EAST / RIGHT button
-  if (py > r_y && py < (r_y + box_h) && px > r_x && px < (r_x + box_w)) {
-    BEEP;
-    if (!guidingEast) {
-      commandWithReply(":Mw#", reply); // east west is swapped for DDScope
-      guidingEast = true;
-      guidingWest = false;
-      guidingNorth = false;
-      guidingSouth = false;
-    } else {
-      commandBool(":Qw#");
-      guidingEast = false;
-    }
-    return true;
-  }
-                  
-  // WEST / LEFT button
-  if (py > l_y && py < (l_y + box_h) && px > l_x && px < (l_x + box_w)) {
-    BEEP;
-    if (!guidingWest) {
-      commandWithReply(":Me#", reply); // east west is swapped for DDScope
-      guidingEast = false;
-      guidingWest = true;
-      guidingNorth = false;
-      guidingSouth = false;
-    } else {
-      commandBool(":Qe#");
-      guidingWest = false;
-    }
-    return true;
-  }
-                  
-  // NORTH / UP button
-  if (py > u_y && py < (u_y + box_h) && px > u_x && px < (u_x + box_w)) {
-    BEEP;
-    if (!guidingNorth) {
-      commandWithReply(":Mn#", reply);
-      guidingEast = false;
-      guidingWest = false;
-      guidingNorth = true;
-      guidingSouth = false;
-    } else {
-      commandBool(":Qn#");
-      guidingNorth = false;
-    }
-    return true;
-  }
-                  
-  // SOUTH / DOWN button
-  if (py > d_y && py < (d_y + box_h) && px > d_x && px < (d_x + box_w)) {
-    BEEP;
-    if (!guidingSouth) {
-      commandWithReply(":Ms#", reply);
-      guidingEast = false;
-      guidingWest = false;
-      guidingNorth = false;
-      guidingSouth = true;
-    } else {
-      commandBool(":Qs#");
-      guidingSouth = false;
-    }
-    return true;
+
+    case AL_START: // START Alignment Button - clear the corrections, reset the state machine
+      BEEP;
+      startAlignBut = true;
+      alignCurStar = 0;
+      numAlignStars = 2; // number of selected align stars from buttons
+      transform.align.modelClear();
+      Current_State = Idle_State;
+
+      // Enable the Motors
+      digitalWrite(AZ_ENABLED_LED_PIN, LOW); // Turn On AZ LED
+      axis1.enable(true); // AZ motor on
+      
+      digitalWrite(ALT_ENABLED_LED_PIN, LOW); // Turn On ALT LED
+      axis2.enable(true); // ALT motor on
+      return true;
+
+    case AL_EAST: // EAST / RIGHT button
+      BEEP;
+      if (!guidingEast) {
+        commandWithReply(":Mw#", reply); // east west is swapped for DDScope
+        guidingEast = true;
+        guidingWest = false;
+        guidingNorth = false;
+        guidingSouth = false;
+      } else {
+        commandBool(":Qw#");
+        guidingEast = false;
+      }
+      return true;
+
+    case AL_WEST: // WEST / LEFT button
+      BEEP;
+      if (!guidingWest) {
+        commandWithReply(":Me#", reply); // east west is swapped for DDScope
+        guidingEast = false;
+        guidingWest = true;
+        guidingNorth = false;
+        guidingSouth = false;
+      } else {
+        commandBool(":Qe#");
+        guidingWest = false;
+      }
+      return true;
+
+    case AL_NORTH: // NORTH / UP button
+      BEEP;
+      if (!guidingNorth) {
+        commandWithReply(":Mn#", reply);
+        guidingEast = false;
+        guidingWest = false;
+        guidingNorth = true;
+        guidingSouth = false;
+      } else {
+        commandBool(":Qn#");
+        guidingNorth = false;
+      }
+      return true;
+
+    case AL_SOUTH: // SOUTH / DOWN button
+      BEEP;
+      if (!guidingSouth) {
+        commandWithReply(":Ms#", reply);
+        guidingEast = false;
+        guidingWest = false;
+        guidingNorth = false;
+        guidingSouth = true;
+      } else {
+        commandBool(":Qs#");
+        guidingSouth = false;
+      }
+      return true;
   }
 
   // Check emergeyncy ABORT button area
@@ -732,29 +693,10 @@ void AlignScreen::saveAlignState() {
 
 // ========== Update Guide Page Buttons ==========
 void AlignScreen::updateGuideButtons() {
-  if (guidingEast && mount.isSlewing()) { 
-    alignButton.draw(r_x, r_y, box_w, box_h, "EAST", BUT_ON);
-  } else {
-    alignButton.draw(r_x, r_y, box_w, box_h, "EAST", BUT_OFF);
-  }
-
-  if (guidingWest && mount.isSlewing()) { 
-    alignButton.draw(l_x, l_y, box_w, box_h, "WEST", BUT_ON);
-  } else {
-    alignButton.draw(l_x, l_y, box_w, box_h, "WEST", BUT_OFF);
-  }
-
- if (guidingNorth && mount.isSlewing()) { 
-    alignButton.draw(u_x, u_y, box_w, box_h, "NORTH", BUT_ON);
-  } else {
-    alignButton.draw(u_x, u_y, box_w, box_h, "NORTH", BUT_OFF);
-  }
-
-  if (guidingSouth && mount.isSlewing()) { 
-    alignButton.draw(d_x, d_y, box_w, box_h, "SOUTH", BUT_ON);
-  } else {
-    alignButton.draw(d_x, d_y, box_w, box_h, "SOUTH", BUT_OFF);
-  }
+  alignLayout.drawButton(AL_EAST,  guidingEast  && mount.isSlewing());
+  alignLayout.drawButton(AL_WEST,  guidingWest  && mount.isSlewing());
+  alignLayout.drawButton(AL_NORTH, guidingNorth && mount.isSlewing());
+  alignLayout.drawButton(AL_SOUTH, guidingSouth && mount.isSlewing());
 }
 
 // ***** Show Calculated Corrections ******
@@ -37,7 +37,6 @@ class AlignScreen : public Display {
     void stateMachine();
     void showAlignStatus();
     void showCorrections();
-    void drawGuideButtons();
     void updateGuideButtons();
 
     uint8_t alignCurStar = 0; // current align star number
@@ -69,22 +68,6 @@ class AlignScreen : public Display {
     bool guidingNorth = false;
     bool guidingSouth = false;
     bool guidingDone = false;
-
-    int center_x = TFTWIDTH/2 + 50;
-    int center_y = TFTHEIGHT/2+ 30;
-    int box_w = 60;
-    int box_h = 40;
-    int but_spacer = 4;
-    int r_x = center_x + box_w/2 + but_spacer;
-    int l_x = center_x - box_w/2 - box_w - but_spacer;
-    int u_x = center_x - box_w/2;
-    int d_x = u_x;
-    int r_y = center_y - box_h/2;
-    int l_y = r_y;
-    int u_y = center_y - box_h - but_spacer;
-    int d_y = center_y + but_spacer;
-    //int u_y = center_y - box_h/2 - box_h - but_spacer;
-    //int d_y = center_y + box_h/2 + but_spacer;
 };
 
 extern AlignScreen alignScreen;
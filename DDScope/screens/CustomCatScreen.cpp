@@ -62,11 +62,11 @@ double dcAlt[MAX_CUSTOM_CATALOG_ROWS];
 double dcAzm[MAX_CUSTOM_CATALOG_ROWS];
 
 // Catalog Button object for default Arial font
-Button customDefButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline,
+Button customDefButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline,
                        defFontWidth, defFontHeight, "");
 
 // Catalog Button object for custom font
-Button customCatButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline,
+Button customCatButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline,
                        mainFontWidth, mainFontHeight, "");
 
 // Canvas Print object default Arial 6x9 font
@@ -205,10 +205,11 @@ void CustomCatScreen::parseCcatIntoArray() {
 }
 
 // ========== draw CUSTOM Screen of catalog data ========
-void CustomCatScreen::drawCustomCat() {
+// scroll = 0 redraws the list in place, NEXT (> 0) and BACK (< 0) bring the
+// new page in one row at a time through the hardware scroll area
+void CustomCatScreen::drawCustomCat(int8_t scroll) {
   // write the top and bottom areas of screen
   tft.fillRect(6, 9, 77, 32, butBackground);   // erase page numbers
-  tft.fillRect(2, 60, 317, 353, pgBackground); // clear lower screen
   tft.setFont(0);                              // revert to basic Arial font
   prevAbsIndex = 0;
 
@@ -250,16 +251,14 @@ void CustomCatScreen::drawCustomCat() {
   SERIAL_DEBUG.print("startAbsIndex="); SERIAL_DEBUG.println(startAbsIndex);
   SERIAL_DEBUG.print("rowsThisPage="); SERIAL_DEBUG.println(rowsThisPage);
 
-  drawPageData(startAbsIndex);
+  drawPageData(startAbsIndex, scroll);
 }
 
-void CustomCatScreen::drawPageData(uint8_t startAbsIndex) {
-  char catLine[50] = "";
-
+void CustomCatScreen::drawPageData(uint8_t startAbsIndex, int8_t scroll) {
+  rowIndex = 0;
   for (uint8_t i = 0; i < rowsThisPage; ++i) {
     uint8_t absIndex = startAbsIndex + i;
     if (absIndex >= totalNumRows) break;
-    rowIndex = i;
 
     //SERIAL_DEBUG.print("rowIndex="); SERIAL_DEBUG.println(rowIndex);
     // ======== process RA/DEC ===========
@@ -296,28 +295,26 @@ void CustomCatScreen::drawPageData(uint8_t startAbsIndex) {
       continue;
     }
 
-    // Draw row content
-    uint16_t y = CUS_Y + (rowIndex * (CUS_H + CUS_Y_SPACING));
-    //SERIAL_DEBUG.print("y="); SERIAL_DEBUG.println(y);
-    tft.fillRect(CUS_X + CUS_W + 2, y, 197, 17, butBackground);
-    //tft.setCursor(CUS_X + CUS_W + 2, y);
-    customDefButton.drawLJ(CUS_X, y, CUS_W, CUS_H, cArray[absIndex].cObjName, BUT_OFF);
-
-    snprintf(catLine, sizeof(catLine), "%-4s|%-4s|%-14s|%-7s",
-             cArray[absIndex].cMag,
-             cArray[absIndex].cCons,
-             cArray[absIndex].cObjType,
-             cArray[absIndex].cSubId);
-
-    tft.setCursor(CUS_X + CUS_W + SUB_STR_X_OFF + 2, y + FONT_Y_OFF);
-    tft.print(catLine);
-    //SERIAL_DEBUG.print("catLine["); SERIAL_DEBUG.print(rowIndex); SERIAL_DEBUG.print("] = "); SERIAL_DEBUG.println(catLine);
-
     // Store mapping of screen row to absolute index
     cFiltArray[rowIndex] = absIndex;
     rowIndex++;
   }
 
+  if (scroll == 0) {
+    tft.fillRect(2, 60, 317, 353, pgBackground); // clear lower screen
+    for (uint8_t i = 0; i < rowIndex; i++) drawRow(i, i);
+  } else {
+    // a row per step, see SHCCatScreen::drawShcCat()
+    tft.setScrollArea(CUS_Y, NUM_CATALOG_ROWS_PER_SCREEN * (CUS_H + CUS_Y_SPACING));
+    for (uint8_t step = 0; step < NUM_CATALOG_ROWS_PER_SCREEN; step++) {
+      uint8_t i   = (scroll > 0) ? step : NUM_CATALOG_ROWS_PER_SCREEN - 1 - step;
+      uint8_t pos = (scroll > 0) ? NUM_CATALOG_ROWS_PER_SCREEN - 1 : 0;
+      tft.scrollArea((scroll > 0) ? (CUS_H + CUS_Y_SPACING) : -(CUS_H + CUS_Y_SPACING));
+      tft.fillRect(2, CUS_Y + pos * (CUS_H + CUS_Y_SPACING), 317, CUS_H + CUS_Y_SPACING, pgBackground);
+      if (i < rowIndex) drawRow(i, pos);
+    }
+  }
+
   if (rowIndex == 0) {
     canvCustomInsPrint.printRJ(STATUS_STR_X, STATUS_STR_Y, STATUS_STR_W, STATUS_STR_H, "None above 10 deg", true);
   }
@@ -325,6 +322,28 @@ void CustomCatScreen::drawPageData(uint8_t startAbsIndex) {
   // Mark end of list if no further rows
   endOfList = ((startAbsIndex + rowsThisPage) >= totalNumRows);
 }
+
+// Draw the button and data line of a page row at screen row pos
+void CustomCatScreen::drawRow(uint8_t row, uint8_t pos) {
+  char catLine[50] = "";
+  uint8_t absIndex = cFiltArray[row];
+  uint16_t y = CUS_Y + (pos * (CUS_H + CUS_Y_SPACING));
+
+  //SERIAL_DEBUG.print("y="); SERIAL_DEBUG.println(y);
+  tft.fillRect(CUS_X + CUS_W + 2, y, 197, 17, butBackground);
+  //tft.setCursor(CUS_X + CUS_W + 2, y);
+  customDefButton.drawLJ(CUS_X, y, CUS_W, CUS_H, cArray[absIndex].cObjName, BUT_OFF);
+
+  snprintf(catLine, sizeof(catLine), "%-4s|%-4s|%-14s|%-7s",
+           cArray[absIndex].cMag,
+           cArray[absIndex].cCons,
+           cArray[absIndex].cObjType,
+           cArray[absIndex].cSubId);
+
+  tft.setCursor(CUS_X + CUS_W + SUB_STR_X_OFF + 2, y + FONT_Y_OFF);
+  tft.print(catLine);
+  //SERIAL_DEBUG.print("catLine["); SERIAL_DEBUG.print(row); SERIAL_DEBUG.print("] = "); SERIAL_DEBUG.println(catLine);
+}
     
 // show status changes on tasks timer tick
 void CustomCatScreen::updateCustomStatus() {
@@ -513,7 +532,7 @@ bool CustomCatScreen::touchPoll(uint16_t px, uint16_t py) {
       prevPageNum = currentPageNum;
       endOfList = false;
       currentPageNum--;
-      drawCustomCat();
+      drawCustomCat(-1);
       buttonDetected = true;
     }
     return false;
@@ -526,7 +545,7 @@ bool CustomCatScreen::touchPoll(uint16_t px, uint16_t py) {
     if (!endOfList) {
       prevPageNum = currentPageNum;
       currentPageNum++;
-      drawCustomCat();
+      drawCustomCat(1);
       buttonDetected = true;
     }
     return false;
@@ -34,9 +34,10 @@ class CustomCatScreen : public Display {
     void showTargetCoords();
     bool loadCustomArray();
     void parseCcatIntoArray();
-    void drawCustomCat();
+    void drawCustomCat(int8_t scroll = 0);
     void deleteRow();
-    void drawPageData(uint8_t startAbsIndex);
+    void drawPageData(uint8_t startAbsIndex, int8_t scroll);
+    void drawRow(uint8_t row, uint8_t pos);
 
     bool delSelected = false;
     bool buttonDetected = false;
@@ -124,7 +124,7 @@ void DCFocuserScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Focus");
+  wifiDisplay.saveBufferToSD("Focus");
   #endif
 }
 
@@ -182,9 +182,9 @@ bool DCFocuserScreen::focuserButStateChange() {
 // Focuser Screen Main Button object
 Button focuserButton(
                 0, 0, 0, 0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 mainFontWidth, 
                 mainFontHeight, 
                 "");
@@ -192,9 +192,9 @@ Button focuserButton(
 // Focuser Screen Large Button object
 Button focuserXLargeButton(
                 0, 0, 0, 0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 xlargeFontWidth, 
                 xlargeFontHeight, 
                 "");
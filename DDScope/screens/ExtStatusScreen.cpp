@@ -6,6 +6,7 @@
 // 8/30/2021
 #include "../display/Display.h"
 #include "ExtStatusScreen.h"
+#include "../fonts/Inconsolata_Bold8pt7b.h"
 #include "src/telescope/mount/site/Site.h"
 #include "./src/lib/tasks/OnTask.h"
 
@@ -16,6 +17,11 @@
 #define STATUS_X                 10 
 #define STATUS_Y                104 
 #define STATUS_SPACING           13 
+#define MIRROR_X                186 // right of the short mount status lines, classic 6x8 font
+#define MIRROR_Y                122 // below "String=", clear of the rate compensation line
+#define MIRROR_W                132
+#define MIRROR_SPACING            8
+#define MIRROR_H                (9 * MIRROR_SPACING)
 
 // ========== Draw the Extended Status Screen ==========
 void ExtStatusScreen::draw() {
@@ -44,13 +50,16 @@ void ExtStatusScreen::draw() {
   mountStatus();
   tlsStatus();
   limitsStatus();
+  #ifdef ENABLE_TFT_MIRROR
+  mirrorStatus();
+  #endif
 
   #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.enableScreenCapture(false);
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("xStatus");
+  wifiDisplay.saveBufferToSD("xStatus");
   #endif
 }
   
@@ -61,6 +70,9 @@ void ExtStatusScreen::updateExStatus() {
   //tft.fillRect(STATUS_X, STATUS_Y, 250, TFT_HEIGHT-150, pgBackground);
   //tlsStatus();
   //limitsStatus();
+  #ifdef ENABLE_TFT_MIRROR
+  mirrorStatus();
+  #endif
 }
 
 void ExtStatusScreen::mountStatus() {
@@ -208,4 +220,40 @@ void ExtStatusScreen::limitsStatus() {
   tft.print("Overhead Limit = "); tft.print(exReply);  
 }
 
+#ifdef ENABLE_TFT_MIRROR
+// WiFi mirror codec averages for both kinds of screen, compress ms/KB sent,
+// * marks the codec keyframes currently use. Redrawn with every status update.
+void ExtStatusScreen::mirrorStatus() {
+  static const char* codecNames[CODEC_COUNT] = {"RAW", "RLE", "DEF1", "DEF6", "PAL", "TIL", "CMD"};
+  int y_offset = MIRROR_Y;
+  char line[12];
+
+  tft.fillRect(MIRROR_X, MIRROR_Y, MIRROR_W, MIRROR_H, pgBackground);
+  tft.setFont(0); // 22 columns fit right of the mount status lines
+  tft.setTextColor(textColor);
+  tft.setCursor(MIRROR_X, y_offset);
+  tft.print("Mirror link "); tft.print((int)wifiDisplay.linkBytesPerMs()); tft.print("KB/s");
+
+  y_offset +=MIRROR_SPACING; tft.setCursor(MIRROR_X, y_offset);
+  tft.print("ms/KB   fill  detail");
+
+  for (uint8_t c = 0; c < CODEC_COUNT; c++) {
+    y_offset +=MIRROR_SPACING; tft.setCursor(MIRROR_X, y_offset);
+    snprintf(line, sizeof(line), "%-4s", codecNames[c]);
+    tft.print(line);
+    for (uint8_t frameClass = 0; frameClass < FRAME_CLASSES; frameClass++) {
+      const CodecStats& s = wifiDisplay.codecStats(frameClass, c);
+      if (s.frames == 0) {
+        tft.print("     -   ");
+      } else {
+        snprintf(line, sizeof(line), " %3d/%3d%c", (int)(s.compressUs/1000), (int)(s.bytes/1024),
+                 (c == wifiDisplay.codecChoice(frameClass)) ? '*' : ' ');
+        tft.print(line);
+      }
+    }
+  }
+  tft.setFont(&Inconsolata_Bold8pt7b);
+}
+#endif
+
 ExtStatusScreen extStatusScreen;
@@ -12,6 +12,7 @@ class ExtStatusScreen : public Display {
     void mountStatus();
     void tlsStatus();
     void limitsStatus();
+    void mirrorStatus();
     void updateExStatus();
 
   private: 
@@ -73,9 +73,9 @@
 // Go To Screen Button object
 Button gotoButton(
                 0, 0, 0, 0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 mainFontWidth, 
                 mainFontHeight, 
                 "");
@@ -83,9 +83,9 @@ Button gotoButton(
                 // Go To Screen Button object
 Button gotoLargeButton(
                 0, 0, 0, 0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 largeFontWidth, 
                 largeFontHeight, 
                 "");
@@ -142,7 +142,7 @@ void GotoScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Goto");
+  wifiDisplay.saveBufferToSD("Goto");
   #endif
 } // end initialize
 
@@ -51,12 +51,14 @@
 
 #define EAST_WEST_SWAPPED     // comment out if you don't want to swap east / west guide button actions
 
+#define GUIDE_R_COL(n)          (GUIDE_R_X + (n)*(GUIDE_R_BOXSIZE_X + GUIDE_R_SPACER))
+
 // Guide Screen Button object
 Button guideButton(
                 GUIDE_R_X, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 mainFontWidth, 
                 mainFontHeight, 
                 "");
@@ -64,9 +66,9 @@ Button guideButton(
 // Guide Screen Large Button object
 Button guideLargeButton(
                 GUIDE_R_X, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 largeFontWidth, 
                 largeFontHeight, 
                 "");
@@ -74,6 +76,36 @@ Button guideLargeButton(
 // Canvas Print object Custom Font
 CanvasPrint canvGuideInsPrint(&Inconsolata_Bold8pt7b);
 
+// Guide Screen layout
+enum { GU_STYLE_MAIN, GU_STYLE_LARGE };
+static const UIStyle guideStyles[] = {
+  { &guideButton,      &Inconsolata_Bold8pt7b,  &canvGuideInsPrint },
+  { &guideLargeButton, &UbuntuMono_Bold11pt7b,  &canvGuideInsPrint },
+};
+
+enum {
+  GU_WEST, GU_EAST, GU_NORTH, GU_SOUTH, GU_SYNC,
+  GU_RATE_1X, GU_RATE_8X, GU_RATE_20X, GU_RATE_48X, GU_RATE_HALF_MAX,
+  GU_SPIRAL, GU_STOP, GU_AZM_ENC, GU_ALT_ENC, GU_COUNT
+};
+static const UIElement guideElements[GU_COUNT] = {
+  { GU_WEST,          UI_BUTTON, GU_STYLE_LARGE, LEFT_OFFSET_X,  LEFT_OFFSET_Y,  GUIDE_BOXSIZE_X,   GUIDE_BOXSIZE_Y,   "WEST",       NULL       },
+  { GU_EAST,          UI_BUTTON, GU_STYLE_LARGE, RIGHT_OFFSET_X, RIGHT_OFFSET_Y, GUIDE_BOXSIZE_X,   GUIDE_BOXSIZE_Y,   "EAST",       NULL       },
+  { GU_NORTH,         UI_BUTTON, GU_STYLE_LARGE, UP_OFFSET_X,    UP_OFFSET_Y,    GUIDE_BOXSIZE_X,   GUIDE_BOXSIZE_Y,   "NORTH",      NULL       },
+  { GU_SOUTH,         UI_BUTTON, GU_STYLE_LARGE, DOWN_OFFSET_X,  DOWN_OFFSET_Y,  GUIDE_BOXSIZE_X,   GUIDE_BOXSIZE_Y,   "SOUTH",      NULL       },
+  { GU_SYNC,          UI_BUTTON, GU_STYLE_LARGE, SYNC_OFFSET_X,  SYNC_OFFSET_Y,  GUIDE_BOXSIZE_X,   GUIDE_BOXSIZE_Y,   "SYNC",       "SYNCng"   },
+  { GU_RATE_1X,       UI_BUTTON, GU_STYLE_MAIN,  GUIDE_R_COL(0), GUIDE_R_Y,      GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x",       NULL       },
+  { GU_RATE_8X,       UI_BUTTON, GU_STYLE_MAIN,  GUIDE_R_COL(1), GUIDE_R_Y,      GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "8.0x",       NULL       },
+  { GU_RATE_20X,      UI_BUTTON, GU_STYLE_MAIN,  GUIDE_R_COL(2), GUIDE_R_Y,      GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x",        NULL       },
+  { GU_RATE_48X,      UI_BUTTON, GU_STYLE_MAIN,  GUIDE_R_COL(3), GUIDE_R_Y,      GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x",        NULL       },
+  { GU_RATE_HALF_MAX, UI_BUTTON, GU_STYLE_MAIN,  GUIDE_R_COL(4), GUIDE_R_Y,      GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max",    NULL       },
+  { GU_SPIRAL,        UI_BUTTON, GU_STYLE_MAIN,  SPIRAL_X,       SPIRAL_Y,       SPIRAL_BOXSIZE_X,  SPIRAL_BOXSIZE_Y,  "Spiral Off", "Spiral On"},
+  { GU_STOP,          UI_BUTTON, GU_STYLE_MAIN,  STOP_X,         STOP_Y,         STOP_BOXSIZE_X,    STOP_BOXSIZE_Y,    "STOP",       "Stopped"  },
+  { GU_AZM_ENC,       UI_VALUE,  GU_STYLE_MAIN,  3,              210,            106,               16,                NULL,         NULL       },
+  { GU_ALT_ENC,       UI_VALUE,  GU_STYLE_MAIN,  3,              230,            106,               16,                NULL,         NULL       },
+};
+static UILayout guideLayout(guideElements, GU_COUNT, guideStyles);
+
 // Draw the GUIDE Page
 void GuideScreen::draw() { 
   setCurrentScreen(GUIDE_SCREEN);
@@ -98,7 +130,7 @@ void GuideScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Guide");
+  wifiDisplay.saveBufferToSD("Guide");
   #endif
 }
 
@@ -109,21 +141,13 @@ void GuideScreen::updateGuideStatus() {
 
   // show the current Encoder positions
   #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive AZM encoder positions
-    sprintf(cAZMposition, "AZM deg= %4.1f", oDriveExt.getEncoderPositionDeg(AZM_MOTOR));
-  #elif
-    AZEncPos = 0; // define this for non ODrive implementations
+    // both from one snapshot, -9.9 as from the getters when the ODrive isn't answering
+    const ODriveSnapshot& od = oDriveExt.snapshot();
+    sprintf(cAZMposition, "AZM deg= %4.1f", od.valid ? od.axis[AZM_MOTOR].position*360 : -9.9);
+    sprintf(cALTposition, "ALT deg= %4.1f", od.valid ? od.axis[ALT_MOTOR].position*360 : -9.9);
   #endif
-  canvGuideInsPrint.printRJ(3, 210, 106, 16, cAZMposition, false);
-
-  // ALT encoder
- #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive AZM encoder positions
-    sprintf(cALTposition, "ALT deg= %4.1f", oDriveExt.getEncoderPositionDeg(ALT_MOTOR));
-  #elif
-    AZEncPos = 0; // define this for non ODrive implementations
-  #endif
-  canvGuideInsPrint.printRJ(3, 230, 106, 16, cALTposition, false);
+  guideLayout.drawValue(GU_AZM_ENC, cAZMposition, false);
+  guideLayout.drawValue(GU_ALT_ENC, cALTposition, false);
 }
 
 bool GuideScreen::guideButStateChange() {
@@ -154,160 +178,61 @@ bool GuideScreen::guideButStateChange() {
 }
 
 // ========== Update Guide Page Buttons ==========
+// Only buttons whose label or state changed since the last call are drawn again
 void GuideScreen::updateGuideButtons() {
-   tft.setFont(&UbuntuMono_Bold11pt7b); 
-
-  if (guidingEast && mount.isSlewing()) { 
-    guideLargeButton.draw(RIGHT_OFFSET_X, RIGHT_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "EAST", BUT_ON);
-  } else {
-    guideLargeButton.draw(RIGHT_OFFSET_X, RIGHT_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "EAST", BUT_OFF);
-    guidingEast = false;
-  }
-
-  if (guidingWest && mount.isSlewing()) { 
-    guideLargeButton.draw(LEFT_OFFSET_X, LEFT_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "WEST", BUT_ON);
-  } else {
-    guideLargeButton.draw(LEFT_OFFSET_X, LEFT_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "WEST", BUT_OFF);
-    guidingWest = false;
-  }
-
- if (guidingNorth && mount.isSlewing()) { 
-    guideLargeButton.draw(UP_OFFSET_X, UP_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "NORTH", BUT_ON);
-  } else {
-    guideLargeButton.draw(UP_OFFSET_X, UP_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "NORTH", BUT_OFF);
+  if (!mount.isSlewing()) {
+    guidingEast  = false;
+    guidingWest  = false;
     guidingNorth = false;
-  }
-
-  if (guidingSouth && mount.isSlewing()) { 
-    guideLargeButton.draw(DOWN_OFFSET_X, DOWN_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "SOUTH", BUT_ON);
-  } else {
-    guideLargeButton.draw(DOWN_OFFSET_X, DOWN_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "SOUTH", BUT_OFF);
     guidingSouth = false;
   }
-  
+  guideLayout.drawButton(GU_EAST,  guidingEast);
+  guideLayout.drawButton(GU_WEST,  guidingWest);
+  guideLayout.drawButton(GU_NORTH, guidingNorth);
+  guideLayout.drawButton(GU_SOUTH, guidingSouth);
+
+  guideLayout.drawButton(GU_SYNC, syncOn);
   if (syncOn) {
-    guideLargeButton.draw(SYNC_OFFSET_X, SYNC_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "SYNCng", BUT_ON);
     syncOn = false;
     display._redrawBut = true;
-  } else {
-    guideLargeButton.draw(SYNC_OFFSET_X, SYNC_OFFSET_Y, GUIDE_BOXSIZE_X, GUIDE_BOXSIZE_Y, "SYNC", BUT_OFF); 
   }
-  tft.setFont(&Inconsolata_Bold8pt7b); 
 
-  // Draw Guide Rates Buttons
+  // Guide Rates Buttons
   // :RG#       Set guide rate: Guiding        1X
   // :RC#       Set guide rate: Centering      8X
   // :RM#       Set guide rate: Find          20X
   // :RF#       Set guide rate: Fast          48X
   // :RS#       Set guide rate: Slew           ?X (1/2 of current goto rate)
   // :Rn#       Set guide rate to n, where n = 0..9
-  char guideRateText[10];
-  switch (guide.settings.axis1RateSelect) {
-    case 0:  strcpy(guideRateText, " Quarter"); break;
-    case 1:  strcpy(guideRateText, "  Half  "); break;
-    case 2:  strcpy(guideRateText, "    1X  "); break;
-    case 3:  strcpy(guideRateText, "    2X  "); break;
-    case 4:  strcpy(guideRateText, "    4X  "); break;
-    case 5:  strcpy(guideRateText, "    8X  "); break; // Center
-    case 6:  strcpy(guideRateText, "   20X  "); break; // Find
-    case 7:  strcpy(guideRateText, "   48X  "); break; // Fast
-    case 8:  strcpy(guideRateText, "Half Max"); break; // Very Fast
-    case 9:  strcpy(guideRateText, "   Max  "); break;
-    case 10: strcpy(guideRateText, " Custom "); break;
-    default: strcpy(guideRateText, "  Error "); break;
-  }
+  guideLayout.drawButton(GU_RATE_1X,       oneXisOn);
+  guideLayout.drawButton(GU_RATE_8X,       eightXisOn);
+  guideLayout.drawButton(GU_RATE_20X,      twentyXisOn);
+  guideLayout.drawButton(GU_RATE_48X,      fourtyEightXisOn);
+  guideLayout.drawButton(GU_RATE_HALF_MAX, HalfMaxisOn);
 
-  int x_offset = 0;
-  int spacer = GUIDE_R_SPACER;
-  if (oneXisOn) {   
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x", BUT_ON);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "8.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max", BUT_OFF); 
-  } 
-
-  if (eightXisOn) {   
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, " 8x", BUT_ON);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max", BUT_OFF); 
-  } 
-
-  if (twentyXisOn) {   
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, " 8x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x", BUT_ON);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max", BUT_OFF); 
-  }   
-
-  if (fourtyEightXisOn) {
-   guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "8.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x", BUT_ON);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max", BUT_OFF); 
-  }
+  guideLayout.drawButton(GU_SPIRAL, spiralOn);
 
-  if (HalfMaxisOn) {
-   guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "0.5x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1.0x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "20x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "48x", BUT_OFF);
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    guideButton.draw(GUIDE_R_X+x_offset, GUIDE_R_Y, GUIDE_R_BOXSIZE_X, GUIDE_R_BOXSIZE_Y, "1/2 Max", BUT_ON); 
-  }        
-
-  if (spiralOn) {  
-    guideButton.draw(SPIRAL_X, SPIRAL_Y, SPIRAL_BOXSIZE_X, SPIRAL_BOXSIZE_Y, "Spiral On", BUT_ON);    
-  } else {
-    guideButton.draw(SPIRAL_X, SPIRAL_Y, SPIRAL_BOXSIZE_X, SPIRAL_BOXSIZE_Y, "Spiral Off", BUT_OFF); 
-  }    
-
-  if (stopPressed) {  
-    guideButton.draw(STOP_X, STOP_Y, STOP_BOXSIZE_X, STOP_BOXSIZE_Y, "Stoppped", BUT_ON); 
+  guideLayout.drawButton(GU_STOP, stopPressed);
+  if (stopPressed) {
     stopPressed = false;
     display._redrawBut = true;
-  } else {
-    guideButton.draw(STOP_X, STOP_Y, STOP_BOXSIZE_X, STOP_BOXSIZE_Y, "STOP", BUT_OFF);
-  } 
+  }
 }
 
 // Manage Touching of Guiding Buttons
 bool GuideScreen::touchPoll(uint16_t px, uint16_t py) {
   char reply[20];
-    // SYNC Button 
-    if (py > SYNC_OFFSET_Y && py < (SYNC_OFFSET_Y + GUIDE_BOXSIZE_Y) && px > SYNC_OFFSET_X && px < (SYNC_OFFSET_X + GUIDE_BOXSIZE_X)) { 
-      BEEP;           
-        commandBool(":CS#"); // doesn't have reply
-        syncOn = true;
-        return true;  
-    }
-                 
-    // guiding WEST / LEFT button
-    if (py > LEFT_OFFSET_Y && py < (LEFT_OFFSET_Y + GUIDE_BOXSIZE_Y) && px > LEFT_OFFSET_X && px < (LEFT_OFFSET_X + GUIDE_BOXSIZE_X)) {
-      BEEP; 
+  uint8_t id = guideLayout.hitTest(px, py);
+
+  switch (id) {
+    case GU_SYNC:
+      BEEP;
+      commandBool(":CS#"); // doesn't have reply
+      syncOn = true;
+      return true;
+
+    case GU_WEST: // guiding WEST / LEFT button
+      BEEP;
       if (!guidingWest) {
         #ifdef EAST_WEST_SWAPPED 
           commandWithReply(":Me#", reply);
@@ -315,7 +240,7 @@ bool GuideScreen::touchPoll(uint16_t px, uint16_t py) {
           commandWithReply(":Mw#", reply);
         #endif 
         guidingWest = true;
-      } else if (!mount.isSlewing() || guidingWest) {
+      } else {
         #ifdef EAST_WEST_SWAPPED 
           commandBool(":Qe#");
         #else
@@ -324,11 +249,9 @@ bool GuideScreen::touchPoll(uint16_t px, uint16_t py) {
         guidingWest = false;
       }
       return true;
-    }
-                    
-    // guiding EAST / RIGHT button
-    if (py > RIGHT_OFFSET_Y && py < (RIGHT_OFFSET_Y + GUIDE_BOXSIZE_Y) && px > RIGHT_OFFSET_X && px < (RIGHT_OFFSET_X + GUIDE_BOXSIZE_X)) {
-      BEEP; 
+
+    case GU_EAST: // guiding EAST / RIGHT button
+      BEEP;
       if (!guidingEast) {
         #ifdef EAST_WEST_SWAPPED 
           commandWithReply(":Mw#", reply);
@@ -336,7 +259,7 @@ bool GuideScreen::touchPoll(uint16_t px, uint16_t py) {
           commandWithReply(":Me#", reply);
         #endif
         guidingEast = true;
-      } else if (!mount.isSlewing() || guidingEast) {
+      } else {
         #ifdef EAST_WEST_SWAPPED 
           commandBool(":Qw#");
         #else
@@ -345,140 +268,70 @@ bool GuideScreen::touchPoll(uint16_t px, uint16_t py) {
         guidingEast = false;
       }
       return true;
-    }
-                    
-    // NORTH / UP button
-    if (py > UP_OFFSET_Y && py < (UP_OFFSET_Y + GUIDE_BOXSIZE_Y) && px > UP_OFFSET_X && px < (UP_OFFSET_X + GUIDE_BOXSIZE_X)) {
-      BEEP; 
+
+    case GU_NORTH: // NORTH / UP button
+      BEEP;
       if (!guidingNorth) {
         commandWithReply(":Mn#", reply);
         guidingNorth = true;
-      } else if (!mount.isSlewing() || guidingNorth) {
+      } else {
         commandBool(":Qn#");
         guidingNorth = false;
       }
       return true;
-    } 
-                    
-    // SOUTH / DOWN button
-    if (py > DOWN_OFFSET_Y && py < (DOWN_OFFSET_Y + GUIDE_BOXSIZE_Y) && px > DOWN_OFFSET_X && px < (DOWN_OFFSET_X + GUIDE_BOXSIZE_X)) {
-      BEEP; 
+
+    case GU_SOUTH: // SOUTH / DOWN button
+      BEEP;
       if (!guidingSouth) {
         commandWithReply(":Ms#", reply);
         guidingSouth = true;
-      } else if (!mount.isSlewing() || guidingSouth) {
+      } else {
         commandBool(":Qs#");
         guidingSouth = false;
       }
       return true;
-    } 
-
-    // :RG#       Set guide rate: Guiding        1X
-    // :RC#       Set guide rate: Centering      8X
-    // :RM#       Set guide rate: Find          20X
-    // :RF#       Set guide rate: Fast          48X
-    // :RS#       Set guide rate: Slew           ?X (1/2 of current goto rate)
-    // :Rn#       Set guide rate to n, where n = 0..9
-    // Select Guide Rates
-    int y_offset = 0;
-    int x_offset = 0;  
-    int spacer = GUIDE_R_SPACER;
-    
-    // 1x Guide Rate 
-    if (py > GUIDE_R_Y+y_offset && py < (GUIDE_R_Y+y_offset + GUIDE_R_BOXSIZE_Y) && px > GUIDE_R_X+x_offset && px < (GUIDE_R_X+x_offset + GUIDE_R_BOXSIZE_X)) {
-      BEEP;
-        commandBool(":R2#");
-        oneXisOn = true;
-        eightXisOn = false;
-        twentyXisOn = false;
-        fourtyEightXisOn = false;
-        HalfMaxisOn = false;
-        return true;
-    }
-
-    // 8x Guide Rate 
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    if (py > GUIDE_R_Y+y_offset && py < (GUIDE_R_Y+y_offset + GUIDE_R_BOXSIZE_Y) && px > GUIDE_R_X+x_offset && px < (GUIDE_R_X+x_offset + GUIDE_R_BOXSIZE_X)) {
-      BEEP;
-        commandBool(":R5#");
-        oneXisOn = false;
-        eightXisOn = true;
-        twentyXisOn = false;
-        fourtyEightXisOn = false;
-        HalfMaxisOn = false;
-        return true;
-    }
 
-    // 20x Rate
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    if (py > GUIDE_R_Y+y_offset && py < (GUIDE_R_Y+y_offset + GUIDE_R_BOXSIZE_Y) && px > GUIDE_R_X+x_offset && px < (GUIDE_R_X+x_offset + GUIDE_R_BOXSIZE_X)) {
+    // Select Guide Rates, 1x 8x 20x 48x and Half Max for slewing
+    case GU_RATE_1X:
+    case GU_RATE_8X:
+    case GU_RATE_20X:
+    case GU_RATE_48X:
+    case GU_RATE_HALF_MAX: {
+      static const char* rateCmd[] = { ":R2#", ":R5#", ":R6#", ":R7#", ":R8#" };
       BEEP;
-        commandBool(":R6#");
-        oneXisOn = false;
-        eightXisOn = false;
-        twentyXisOn = true;
-        fourtyEightXisOn = false;
-        HalfMaxisOn = false;
-        return true;
-    }
-
-    // 48x Rate for Moving
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    if (py > GUIDE_R_Y+y_offset && py < (GUIDE_R_Y+y_offset + GUIDE_R_BOXSIZE_Y) && px > GUIDE_R_X+x_offset && px < (GUIDE_R_X+x_offset + GUIDE_R_BOXSIZE_X)) {
-      BEEP;
-        commandBool(":R7#");
-        oneXisOn = false;
-        eightXisOn = false;
-        twentyXisOn = false;
-        fourtyEightXisOn = true;
-        HalfMaxisOn = false;
-        return true;
+      commandBool(rateCmd[id - GU_RATE_1X]);
+      oneXisOn         = (id == GU_RATE_1X);
+      eightXisOn       = (id == GU_RATE_8X);
+      twentyXisOn      = (id == GU_RATE_20X);
+      fourtyEightXisOn = (id == GU_RATE_48X);
+      HalfMaxisOn      = (id == GU_RATE_HALF_MAX);
+      return true;
     }
 
-    // Half Max Rate for Slewing
-    x_offset = x_offset + GUIDE_R_BOXSIZE_X+spacer;
-    if (py > GUIDE_R_Y+y_offset && py < (GUIDE_R_Y+y_offset + GUIDE_R_BOXSIZE_Y) && px > GUIDE_R_X+x_offset && px < (GUIDE_R_X+x_offset + GUIDE_R_BOXSIZE_X)) {
+    case GU_SPIRAL: // Spiral Search
       BEEP;
-        commandBool(":R8#");
-        oneXisOn = false;
-        eightXisOn = false;
-        twentyXisOn = false;
-        fourtyEightXisOn = false;
-        HalfMaxisOn = true;
-        return true;
-    }
+      if (!spiralOn) {
+        commandBool(":Mp#");
+        spiralOn = true;
+      } else {
+        commandBool(":Q#"); // stop moves
+        spiralOn = false;
+      }
+      return true;
 
-    // Spiral Search
-    if (py > SPIRAL_Y && py < (SPIRAL_Y + SPIRAL_BOXSIZE_Y) && px > SPIRAL_X && px < (SPIRAL_X + SPIRAL_BOXSIZE_X)) {
-      BEEP;
-        if (!spiralOn) {
-            commandBool(":Mp#");
-            spiralOn = true;
-        } else {
-            commandBool(":Q#"); // stop moves
-            spiralOn = false;
-        }
-        return true;
-    }
-    
-    // STOP moving
-    if (py > STOP_Y && py < (STOP_Y + STOP_BOXSIZE_Y) && px > STOP_X && px < (STOP_X + STOP_BOXSIZE_X)) {
+    case GU_STOP: // STOP moving
       ALERT;
-        commandBool(":Q#");
-        digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZM LED
-        //axis1.enable(false);
-        digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
-        //axis2.enable(false);
-        //commandBool(":Td#"); // Disable Tracking
-        
-        stopPressed = true;
-        spiralOn = false;
-        guidingEast = false;
-        guidingWest = false;
-        guidingNorth = false;
-        guidingSouth = false;
-        return true;
-    }
+      commandBool(":Q#");
+      digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZM LED
+      digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
+      stopPressed = true;
+      spiralOn = false;
+      guidingEast = false;
+      guidingWest = false;
+      guidingNorth = false;
+      guidingSouth = false;
+      return true;
+  }
 
   // Check emergeyncy ABORT button area
   display.motorsOff(px, py);
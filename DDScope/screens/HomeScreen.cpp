@@ -100,11 +100,19 @@ const char colOneCmdStr[COL_1_NUM_ROWS][8] = {
 // Home Screen Button object
 Button homeButton(
                 ACTION_COL_1_X, ACTION_COL_1_Y, ACTION_BOXSIZE_X, ACTION_BOXSIZE_Y,
-                butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+                &butOnBackground, &butBackground, &butOutline, mainFontWidth, mainFontHeight, "");
 
 // Canvas Print object Custom Font
 CanvasPrint canvHomeInsPrint(&Inconsolata_Bold8pt7b);
 
+// Retained status fields, only repainted when the value shown changes
+#define COL1_FIELD(row) ValueWidget(&canvHomeInsPrint, COL1_DATA_X, COL1_DATA_Y+(row)*COL1_LABEL_SPACING, C_WIDTH-5, C_HEIGHT)
+#define COL2_FIELD(row) ValueWidget(&canvHomeInsPrint, COL2_DATA_X, COL2_DATA_Y+(row)*COL1_LABEL_SPACING, C_WIDTH-30, C_HEIGHT)
+ValueWidget homeCol1Field[COL_1_NUM_ROWS] = {
+  COL1_FIELD(0), COL1_FIELD(1), COL1_FIELD(2), COL1_FIELD(3), COL1_FIELD(4), COL1_FIELD(5), COL1_FIELD(6)};
+ValueWidget homeCol2Field[COL_2_NUM_ROWS] = {
+  COL2_FIELD(0), COL2_FIELD(1), COL2_FIELD(2), COL2_FIELD(3), COL2_FIELD(4), COL2_FIELD(5)};
+
 // ===============================================
 // ======= Draw Initial content of HOME PAGE =====
 // ===============================================
@@ -160,7 +168,7 @@ void HomeScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Home");
+  wifiDisplay.saveBufferToSD("Home");
   #endif
 }
 
@@ -174,9 +182,7 @@ void HomeScreen::updateHomeStatus() {
   float currentALTMotorCur  = 00.0;
   float currentALTMotorTemp = 00.0;
   float currentAZMotorTemp  = 00.0;
-  char curCol1[11][8] = { {0} };
   char xchReply[13]="";
-  int y_offset = 0;
 
   // Loop through Column 1 poll updates
   for (int i=0; i<COL_1_NUM_ROWS; i++) {
@@ -187,97 +193,45 @@ void HomeScreen::updateHomeStatus() {
       sprintf(xchReply, "%3.1f F", tempF); // convert back to string to right justify
     }
 
-    // only update screen if value is different
-    if (strcmp(curCol1[i], xchReply) != 0) {
-      canvHomeInsPrint.printRJ(COL1_DATA_X, COL1_DATA_Y+y_offset, C_WIDTH-5, C_HEIGHT, xchReply, false);
-      strcpy(curCol1[i], xchReply);
-    }
-    y_offset +=COL1_LABEL_SPACING;
+    // only updates screen if value is different
+    homeCol1Field[i].set(xchReply, false);
   }
 
   //tasks.yield(70); // this yield() is required or lockup happen
 
   // Column 2 poll updates
-  int bitmap_width_sub = 30;
-  y_offset =0;
-
-  #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive AZM encoder positions
-    currentAZEncPos = oDriveExt.getEncoderPositionDeg(AZM_MOTOR);
-  #elif
-    currentAZEncPos = 0; // define this for non ODrive implementations
-  #endif
-  canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentAZEncPos, false);
-
-  
-  // ALT encoder
-  y_offset +=COL1_LABEL_SPACING;
   #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive ALT encoder positions
-    currentALTEncPos = oDriveExt.getEncoderPositionDeg(ALT_MOTOR);
-  #elif
-    currentALTEncPos = 0; // define this for non ODrive implementations
-  #endif
-  canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentALTEncPos, false);
- 
-
-  // AZ current
-  y_offset +=COL1_LABEL_SPACING;
-  #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive AZM motor current
-    currentAZMotorCur = oDriveExt.getMotorCurrent(AZM_MOTOR);
-  #elif
-    currentAZMotorCur = 0; // define this for non ODrive implementations
-  #endif
-  
-  if (abs(currentAZMotorCur) > MOTOR_CURRENT_WARNING) { // change background color...Warning!
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentAZMotorCur, true);
-  } else {
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentAZMotorCur, false);
-  }
+    // one snapshot for all of column 2 instead of a bus read per field
+    const ODriveSnapshot& od = oDriveExt.snapshot();
+    if (od.valid) {
+      // Show ODrive AZM and ALT encoder positions
+      currentAZEncPos = od.axis[AZM_MOTOR].position*360;
+      currentALTEncPos = od.axis[ALT_MOTOR].position*360;
+
+      // Show ODrive AZM and ALT motor current
+      currentAZMotorCur = od.axis[AZM_MOTOR].Iq;
+      currentALTMotorCur = od.axis[ALT_MOTOR].Iq;
+    } else {
+      // ODrive not answering, same arbitrary number as the getters
+      currentAZEncPos = currentALTEncPos = -9.9;
+      currentAZMotorCur = currentALTMotorCur = -9.9;
+    }
 
-  // ALT current
-  y_offset +=COL1_LABEL_SPACING;
-  #ifdef ODRIVE_MOTOR_PRESENT
-    // Show ODrive ALT motor current
-    currentALTMotorCur = oDriveExt.getMotorCurrent(ALT_MOTOR);
-  #elif
-    currentALTMotorCur = 0; // define this for non ODrive implementations
+    // Motor Temperatures, the Teensy reads them with or without the ODrive
+    currentAZMotorTemp = od.axis[AZM_MOTOR].temperature;
+    currentALTMotorTemp = od.axis[ALT_MOTOR].temperature;
   #endif
 
-  if (abs(currentALTMotorCur) > MOTOR_CURRENT_WARNING) {
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentALTMotorCur, true);
-  } else {
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentALTMotorCur, false);
-  }
+  homeCol2Field[0].set(currentAZEncPos, false);
+  homeCol2Field[1].set(currentALTEncPos, false);
 
-  // AZ Motor Temperature
-  y_offset +=COL1_LABEL_SPACING;
-  #ifdef ODRIVE_MOTOR_PRESENT
-    currentAZMotorTemp = oDriveExt.getMotorTemp(AZM_MOTOR);
-  #elif
-    currentAZMotorTemp = 0; // define this for non ODrive implementations
-  #endif
-  
-  if (currentAZMotorTemp >= MAX_MOTOR_TEMP) { // make box red
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentAZMotorTemp, true);
-  } else {
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentAZMotorTemp, false);
-  }
-
-  // ALT Motor Temperature
-  y_offset +=COL1_LABEL_SPACING;
-  #ifdef ODRIVE_MOTOR_PRESENT
-    currentALTMotorTemp = oDriveExt.getMotorTemp(ALT_MOTOR);
-    #elif
-    currentALTMotorTemp = 0; // define this for non ODrive implementations
-  #endif
+  // change background color...Warning!
+  homeCol2Field[2].set(currentAZMotorCur, abs(currentAZMotorCur) > MOTOR_CURRENT_WARNING);
+  homeCol2Field[3].set(currentALTMotorCur, abs(currentALTMotorCur) > MOTOR_CURRENT_WARNING);
 
-  if (currentALTMotorTemp >= MAX_MOTOR_TEMP) { // make box red
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentALTMotorTemp, true);
-  } else {
-    canvHomeInsPrint.printRJ(COL2_DATA_X, COL2_DATA_Y+y_offset, C_WIDTH-bitmap_width_sub, C_HEIGHT, currentALTMotorTemp, false);
-  }
+  // make box red
+  homeCol2Field[4].set(currentAZMotorTemp, currentAZMotorTemp >= MAX_MOTOR_TEMP);
+  homeCol2Field[5].set(currentALTMotorTemp, currentALTMotorTemp >= MAX_MOTOR_TEMP);
 }
 
 bool HomeScreen::homeButStateChange() {
@@ -530,8 +484,12 @@ bool HomeScreen::touchPoll(int16_t px, int16_t py) {
     } else {
       setNightMode(false); // toggle off
     }
-    drawTitle(25, TITLE_TEXT_Y, "DIRECT-DRIVE SCOPE");
-    draw(); // redraw new screen colors
+    if (recolorScreen()) {
+      display._redrawBut = true; // Night / Day Mode button label
+    } else {
+      drawTitle(25, TITLE_TEXT_Y, "DIRECT-DRIVE SCOPE");
+      draw(); // redraw new screen colors
+    }
     return true;
   }
 
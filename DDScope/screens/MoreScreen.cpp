@@ -71,10 +71,10 @@ const char *activeFilterStr[3] = {"Filt: None", "Filt: Abv Hor", "Filt: All Sky"
 
 // More Screen Button object with standard Font size
 Button moreButton(TRACK_R_X, TRACK_R_Y, TRACK_R_BOXSIZE_X, TRACK_R_BOXSIZE_Y,
-                butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+                &butOnBackground, &butBackground, &butOutline, mainFontWidth, mainFontHeight, "");
 
 // More Screen Button object with large Font size
-Button moreLgButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, largeFontWidth, largeFontHeight, "");
+Button moreLgButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline, largeFontWidth, largeFontHeight, "");
 
 // Canvas Print object, Inconsolata_Bold8pt7b font
 CanvasPrint canvMoreInsPrint(&Inconsolata_Bold8pt7b);
@@ -131,7 +131,7 @@ void MoreScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("More");
+  wifiDisplay.saveBufferToSD("More");
   #endif
 }
 
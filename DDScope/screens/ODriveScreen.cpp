@@ -6,6 +6,7 @@
 #include "../../../telescope/mount/Mount.h"
 #include "../fonts/Inconsolata_Bold8pt7b.h"
 #include "src/lib/tasks/OnTask.h"
+#include "../odriveExt/ODriveUart.h"
 #include <ODriveArduino.h> // https://github.com/odriverobotics/ODrive/tree/master/Arduino/ODriveArduino
 
 #define OD_ERR_OFFSET_X 4
@@ -13,6 +14,17 @@
 #define OD_ERR_SPACING 11
 #define OD_BUTTONS_OFFSET 45
 
+// Live plot of the motor telemetry in place of the error list, tap the list to switch
+#define OD_PLOT_X          OD_ERR_OFFSET_X
+#define OD_PLOT_Y          (OD_ERR_OFFSET_Y + 12) // below the legend
+#define OD_PLOT_W          197
+#define OD_PLOT_BAND_H     40    // position error, Iq, velocity from the top
+#define OD_PLOT_H          (3*OD_PLOT_BAND_H)
+#define OD_PLOT_MS         20    // every new sample since the last run gets a column
+#define OD_PLOT_POS_RANGE  0.01  // turns, +/- half a band
+#define OD_PLOT_IQ_RANGE   4.0   // amps
+#define OD_PLOT_VEL_RANGE  0.5   // turns/s
+
 // Buttons for actions that are not page selections
 #define OD_ACT_BOXSIZE_X 100
 #define OD_ACT_BOXSIZE_Y 36
@@ -24,6 +36,13 @@
 #define OD_ACT_COL_3_Y OD_ACT_COL_1_Y
 #define OD_ACT_X_SPACING 7
 #define OD_ACT_Y_SPACING 3
+#define OD_ACT_ROW_Y(n) (OD_ACT_COL_1_Y + (n)*(OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING))
+
+// Gain and Demo buttons are shorter
+#define OD_GAIN_BOXSIZE_Y (OD_ACT_BOXSIZE_Y - 10)
+#define OD_GAIN_Y_OFFSET 160 // 3rd column gain buttons start this far above the action buttons
+#define OD_GAIN_Y (OD_ACT_COL_3_Y - OD_GAIN_Y_OFFSET)
+#define OD_GAIN_ROW_Y(n) (OD_GAIN_Y + (n)*(OD_GAIN_BOXSIZE_Y + OD_ACT_Y_SPACING))
 
 // Printing with stream operator helper functions
 template <class T> inline Print &operator<<(Print &obj, T arg) {
@@ -37,12 +56,41 @@ template <> inline Print &operator<<(Print &obj, float arg) {
 
 // ODrive Screen Button object
 Button odriveButton(OD_ACT_COL_1_X, OD_ACT_COL_1_Y, OD_ACT_BOXSIZE_X,
-                    OD_ACT_BOXSIZE_Y, butOnBackground, butBackground,
-                    butOutline, mainFontWidth, mainFontHeight, "");
+                    OD_ACT_BOXSIZE_Y, &butOnBackground, &butBackground,
+                    &butOutline, mainFontWidth, mainFontHeight, "");
+
+// ODrive Screen layout
+static const UIStyle odriveStyles[] = {
+  { &odriveButton, &Inconsolata_Bold8pt7b, NULL },
+};
+
+enum {
+  OD_EN_AZM, OD_EN_ALT, OD_STOP, OD_CLR_ERRS,
+  OD_AZ_GAIN_HI, OD_AZ_GAIN_DEF, OD_ALT_GAIN_HI, OD_ALT_GAIN_DEF,
+  OD_DEMO, OD_RESET, OD_MTR_LOOP, OD_COUNT
+};
+static const UIElement odriveElements[OD_COUNT] = {
+  { OD_EN_AZM,       UI_BUTTON, 0, OD_ACT_COL_1_X, OD_ACT_ROW_Y(1),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "EN AZM",       "AZM Enabled"  },
+  { OD_EN_ALT,       UI_BUTTON, 0, OD_ACT_COL_1_X, OD_ACT_ROW_Y(2),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "EN ALT",       "ALT Enabled"  },
+  { OD_STOP,         UI_BUTTON, 0, OD_ACT_COL_2_X, OD_ACT_ROW_Y(1),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "Motors OFF",   "All Stop'd"   },
+  { OD_CLR_ERRS,     UI_BUTTON, 0, OD_ACT_COL_2_X, OD_ACT_ROW_Y(2),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "Clr Errors",   "Errs Cleared" },
+  { OD_AZ_GAIN_HI,   UI_BUTTON, 0, OD_ACT_COL_3_X, OD_GAIN_ROW_Y(0), OD_ACT_BOXSIZE_X, OD_GAIN_BOXSIZE_Y, "AZ Gain Hi",   NULL           },
+  { OD_AZ_GAIN_DEF,  UI_BUTTON, 0, OD_ACT_COL_3_X, OD_GAIN_ROW_Y(1), OD_ACT_BOXSIZE_X, OD_GAIN_BOXSIZE_Y, "AZ Gain Def",  NULL           },
+  { OD_ALT_GAIN_HI,  UI_BUTTON, 0, OD_ACT_COL_3_X, OD_GAIN_ROW_Y(2), OD_ACT_BOXSIZE_X, OD_GAIN_BOXSIZE_Y, "ALT Gain Hi",  NULL           },
+  { OD_ALT_GAIN_DEF, UI_BUTTON, 0, OD_ACT_COL_3_X, OD_GAIN_ROW_Y(3), OD_ACT_BOXSIZE_X, OD_GAIN_BOXSIZE_Y, "ALT Gain Def", NULL           },
+  { OD_DEMO,         UI_BUTTON, 0, OD_ACT_COL_3_X, OD_ACT_ROW_Y(0),  OD_ACT_BOXSIZE_X, OD_GAIN_BOXSIZE_Y, "Demo ODrive",  "Demo Active"  },
+  { OD_RESET,        UI_BUTTON, 0, OD_ACT_COL_3_X, OD_ACT_ROW_Y(1),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "Rst ODrive",   "Resetting"    },
+  { OD_MTR_LOOP,     UI_BUTTON, 0, OD_ACT_COL_3_X, OD_ACT_ROW_Y(2),  OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y,  "Mtr Loop Off", "Mtr Loop On"  },
+};
+static UILayout odriveLayout(odriveElements, OD_COUNT, odriveStyles);
 
 // Demo Mode Wrapper
 void demoWrapper() { oDriveExt.demoMode(); }
 
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+void plotWrapper() { oDriveScreen.drawPlot(); }
+#endif
+
 typedef struct ODriveVersion {
   uint16_t hwMajor;
   uint16_t hwMinor;
@@ -68,23 +116,21 @@ void ODriveScreen::draw() {
   tft.setFont(&Inconsolata_Bold8pt7b);
 
 #if ODRIVE_COMM_MODE == OD_UART
-  ODRIVE_SERIAL << "r hw_version_major\n";
-  oDversion.hwMajor = _oDriveDriver->readInt();
-
-  ODRIVE_SERIAL << "r hw_version_minor\n";
-  oDversion.hwMinor = _oDriveDriver->readInt();
-
-  ODRIVE_SERIAL << "r hw_version_variant\n";
-  oDversion.hwVar = _oDriveDriver->readInt();
-
-  ODRIVE_SERIAL << "r fw_version_major\n";
-  oDversion.fwMajor = _oDriveDriver->readInt();
-
-  ODRIVE_SERIAL << "r fw_version_minor\n";
-  oDversion.fwMinor = _oDriveDriver->readInt();
-
-  ODRIVE_SERIAL << "r fw_version_revision\n";
-  oDversion.fwRev = _oDriveDriver->readInt();
+  // all six in one round trip
+  int32_t version[6] = {0, 0, 0, 0, 0, 0};
+  oDriveUart.read("hw_version_major", &version[0]);
+  oDriveUart.read("hw_version_minor", &version[1]);
+  oDriveUart.read("hw_version_variant", &version[2]);
+  oDriveUart.read("fw_version_major", &version[3]);
+  oDriveUart.read("fw_version_minor", &version[4]);
+  oDriveUart.read("fw_version_revision", &version[5]);
+  oDriveUart.wait();
+  oDversion.hwMajor = version[0];
+  oDversion.hwMinor = version[1];
+  oDversion.hwVar = version[2];
+  oDversion.fwMajor = version[3];
+  oDversion.fwMinor = version[4];
+  oDversion.fwRev = version[5];
 #elif ODRIVE_COMM_MODE == OD_CAN
   // needs implemented
   oDversion.hwMajor = 3;
@@ -122,14 +168,18 @@ void ODriveScreen::draw() {
   updateOdriveButtons();
   updateOdriveStatus();
   showGains();
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+  if (plotActive) showPlot(); else showODriveErrors();
+#else
   showODriveErrors();
+#endif
   showGpsStatus();
 #ifdef ENABLE_TFT_MIRROR
   wifiDisplay.enableScreenCapture(false);
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
 #endif
 #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("ODrive");
+  wifiDisplay.saveBufferToSD("ODrive");
 #endif
 }
 
@@ -138,6 +188,89 @@ void ODriveScreen::updateOdriveStatus() {
   // showODriveErrors();
 }
 
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+// ====== Motor telemetry strip chart ======
+// Draws the legend and the last OD_PLOT_W samples, then the plot task adds a
+// column per new sample, sweeping left to right and wrapping like a scope
+void ODriveScreen::showPlot() {
+  tft.fillRect(OD_ERR_OFFSET_X, OD_ERR_OFFSET_Y, 197, 15 * OD_ERR_SPACING, pgBackground);
+  tft.setFont(0);
+  tft.setCursor(OD_ERR_OFFSET_X, OD_ERR_OFFSET_Y);
+  tft.setTextColor(textColor);
+  tft.print("PosErr/Iq/Vel  AZM ");
+  tft.setTextColor(butOnBackground);
+  tft.print("ALT");
+  tft.setTextColor(textColor);
+  for (int band = 0; band < 3; band++)
+    tft.drawFastHLine(OD_PLOT_X, OD_PLOT_Y + band*OD_PLOT_BAND_H + OD_PLOT_BAND_H/2, OD_PLOT_W, butBackground);
+
+  uint32_t count = motorTelemetry.count();
+  plotNext = count > OD_PLOT_W ? count - OD_PLOT_W : 0;
+  plotX = 0;
+  MotorSample s;
+  while (plotNext < count) {
+    if (motorTelemetry.get(plotNext++, s)) plotColumn(s);
+  }
+
+  if (!plotHandle) {
+    VF("MSG: Setup, ODrive plot (rate 20 ms priority 6)... ");
+    plotHandle = tasks.add(OD_PLOT_MS, 0, true, 6, plotWrapper, "OdPlot");
+    if (plotHandle) { VLF("success"); } else { VLF("FAILED!"); }
+  }
+}
+
+// One column at plotX, each trace joined to its previous column so fast
+// changes don't break up into dots
+void ODriveScreen::plotColumn(const MotorSample& s) {
+  static const float range[3] = { OD_PLOT_POS_RANGE, OD_PLOT_IQ_RANGE, OD_PLOT_VEL_RANGE };
+  const float* value[3] = { s.posError, s.Iq, s.velocity };
+  const uint16_t color[2] = { butOnBackground, textColor }; // ALT_MOTOR, AZM_MOTOR
+  int16_t x = OD_PLOT_X + plotX;
+
+  tft.drawFastVLine(x, OD_PLOT_Y, OD_PLOT_H, pgBackground);
+  for (int band = 0; band < 3; band++) {
+    int16_t mid = OD_PLOT_Y + band*OD_PLOT_BAND_H + OD_PLOT_BAND_H/2;
+    tft.drawPixel(x, mid, butBackground);
+    for (int axis = 0; axis < 2; axis++) {
+      float v = constrain(value[band][axis]/range[band], -1.0F, 1.0F);
+      int16_t y = mid - (int16_t)(v*(OD_PLOT_BAND_H/2 - 1));
+      int16_t last = plotX ? plotLastY[band][axis] : y;
+      tft.drawFastVLine(x, min(y, last), abs(y - last) + 1, color[axis]);
+      plotLastY[band][axis] = y;
+    }
+  }
+
+  // blank the next column so the sweep position shows
+  plotX = (plotX + 1) % OD_PLOT_W;
+  tft.drawFastVLine(OD_PLOT_X + plotX, OD_PLOT_Y, OD_PLOT_H, pgBackground);
+}
+
+// Plot task, ends itself when the plot or the screen goes away
+void ODriveScreen::drawPlot() {
+  if (!plotActive || Display::currentScreen != ODRIVE_SCREEN) {
+    tasks.setDurationComplete(plotHandle);
+    plotHandle = 0;
+    return;
+  }
+
+  uint32_t count = motorTelemetry.count();
+  if (plotNext == count) return;
+  if (count - plotNext > OD_PLOT_W) plotNext = count - OD_PLOT_W; // fell behind
+
+#ifdef ENABLE_TFT_MIRROR
+  wifiDisplay.enableScreenCapture(true);
+#endif
+  MotorSample s;
+  while (plotNext < count) {
+    if (motorTelemetry.get(plotNext++, s)) plotColumn(s);
+  }
+#ifdef ENABLE_TFT_MIRROR
+  wifiDisplay.enableScreenCapture(false);
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+#endif
+}
+#endif
+
 // ====== Show the Gains ======
 void ODriveScreen::showGains() {
   // Show AZM Velocity Gain - AZ is motor=1, ALT is motor=0
@@ -568,11 +701,27 @@ uint8_t ODriveScreen::decodeODriveEncErrors(int axis, uint32_t odErrorCode, int
   return errorCount; // Return the number of detected errors
 }
 
+// Error word of an axis component from the snapshot, 99 as from
+// getODriveErrors() when the ODrive isn't answering
+static uint32_t snapshotError(const ODriveSnapshot& od, int axis, Component component) {
+  if (!od.valid) return 99;
+  const ODriveAxisSnapshot& a = od.axis[axis];
+  switch (component) {
+    case AXIS:       return a.axisError;
+    case CONTROLLER: return a.controllerFlags;
+    case MOTOR:      return a.motorError;
+    case ENCODER:    return a.encoderError;
+    default:         return 99;
+  }
+}
+
 // ======== Show the ODRIVE errors ========
 void ODriveScreen::showODriveErrors() {
   int y_offset = 0;
-  uint8_t err = 0;
+  uint32_t err = 0;
   uint8_t errCnt = 0;
+  // the axis errors of both axes in one go, the top level error isn't in it
+  const ODriveSnapshot& od = oDriveExt.snapshot();
 
   // **** enum ordering: AXIS=2, CONTROLLER=3, MOTOR=4, ENCODER=5 *****//
   // 
@@ -596,22 +745,22 @@ void ODriveScreen::showODriveErrors() {
   tft.println("----------AZM Errors----------");
   
   y_offset += (OD_ERR_SPACING);
-  err = oDriveExt.getODriveErrors(AZM_MOTOR, AXIS);
+  err = snapshotError(od, AZM_MOTOR, AXIS);
   //sprintf(tempString, "AZM AXIS=%c err=%08lX", AXIS+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveAxisErrors(AZM_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(AZM_MOTOR, CONTROLLER);
+  err = snapshotError(od, AZM_MOTOR, CONTROLLER);
   //sprintf(tempString, "AZM CONTROLLER=%c err=%08lX", CONTROLLER+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveContErrors(AZM_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(AZM_MOTOR, MOTOR);
+  err = snapshotError(od, AZM_MOTOR, MOTOR);
   //sprintf(tempString, "AZM MOTOR=%c err=%08lX", MOTOR+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveMotorErrors(AZM_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(AZM_MOTOR, ENCODER);
+  err = snapshotError(od, AZM_MOTOR, ENCODER);
   //sprintf(tempString, "AZM ENCODER=%c err=%08lX", ENCODER+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveEncErrors(AZM_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING+3);
@@ -620,22 +769,22 @@ void ODriveScreen::showODriveErrors() {
   tft.println("----------ALT Errors----------");
 
   y_offset += OD_ERR_SPACING;
-  err = oDriveExt.getODriveErrors(ALT_MOTOR, AXIS);
+  err = snapshotError(od, ALT_MOTOR, AXIS);
   //sprintf(tempString, "ALT AXIS=%c err=%08lX", AXIS+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveAxisErrors(ALT_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(ALT_MOTOR, CONTROLLER);
+  err = snapshotError(od, ALT_MOTOR, CONTROLLER);
   //sprintf(tempString, "ALT CONTROLLER=%c err=%08lX", CONTROLLER+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveContErrors(ALT_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(ALT_MOTOR, MOTOR);
+  err = snapshotError(od, ALT_MOTOR, MOTOR);
   //sprintf(tempString, "ALT MOTOR=%c err=%08lX", MOTOR+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveMotorErrors(AZM_MOTOR, err, y_offset);
   y_offset += (errCnt * OD_ERR_SPACING);
 
-  err = oDriveExt.getODriveErrors(ALT_MOTOR, ENCODER);
+  err = snapshotError(od, ALT_MOTOR, ENCODER);
   //sprintf(tempString, "ALT ENCODER=%c err=%08lX", ENCODER+48, err); VL(tempString);
   errCnt = oDriveScreen.decodeODriveEncErrors(ALT_MOTOR, err, y_offset);
 }
@@ -671,359 +820,195 @@ bool ODriveScreen::odriveButStateChange() {
 }
 
 // ========  Update ODrive Page Buttons ========
+// Only buttons whose label or state changed since the last call are drawn again
 void ODriveScreen::updateOdriveButtons() {
-
-  tft.setFont(&Inconsolata_Bold8pt7b);
-
-  int x_offset = 0;
-  int y_offset = 0;
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-
   // ----- Column 1 -----
-  // Enable / Disable Azimuth Motor
-  if (axis1.isEnabled()) {
-    odriveButton.draw(OD_ACT_COL_1_X, OD_ACT_COL_1_Y + y_offset, "AZM Enabled",
-                      BUT_ON);
-  } else { // motor off
-    odriveButton.draw(OD_ACT_COL_1_X, OD_ACT_COL_1_Y + y_offset, "EN AZM",
-                      BUT_OFF);
-  }
-
-  // Enable / Disable Altitude Motor
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  if (axis2.isEnabled()) {
-    odriveButton.draw(OD_ACT_COL_1_X, OD_ACT_COL_1_Y + y_offset, "ALT Enabled",
-                      BUT_ON);
-  } else { // motor off
-    odriveButton.draw(OD_ACT_COL_1_X, OD_ACT_COL_1_Y + y_offset, "EN ALT",
-                      BUT_OFF);
-  }
+  odriveLayout.drawButton(OD_EN_AZM, axis1.isEnabled());
+  odriveLayout.drawButton(OD_EN_ALT, axis2.isEnabled());
 
   // ----- Column 2 -----
-  // Stop all movement
-  y_offset = 0;
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  if (OdStopButton) {
-    odriveButton.draw(OD_ACT_COL_2_X, OD_ACT_COL_2_Y + y_offset, "All Stop'd", BUT_ON);
+  // Stop all movement and Clear Errors flash their "done" label once
+  odriveLayout.drawButton(OD_STOP, OdStopButton);
+  odriveLayout.drawButton(OD_CLR_ERRS, clearODriveErrs);
+  if (OdStopButton || clearODriveErrs) {
     OdStopButton = false;
-    display._redrawBut = true;
-  } else {
-    odriveButton.draw(OD_ACT_COL_2_X, OD_ACT_COL_2_Y + y_offset, "Motors OFF", BUT_OFF);
-  }
-
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Clear Errors
-  if (clearODriveErrs) {
-    odriveButton.draw(OD_ACT_COL_2_X, OD_ACT_COL_2_Y + y_offset, "Errs Cleared", BUT_ON);
     clearODriveErrs = false;
     display._redrawBut = true;
-  } else {
-    odriveButton.draw(OD_ACT_COL_2_X, OD_ACT_COL_2_Y + y_offset, "Clr Errors", BUT_OFF);
-  }
-
-  // ----- 3rd Column -----
-  y_offset = -160;
-
-  // AZ Gains High
-  if (!oDriveExt.AZgainHigh) {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "AZ Gain Hi", BUT_OFF);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "AZ Gain Hi", BUT_ON);
-  }
-
-  // AZ Gains Default
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (!oDriveExt.AZgainDefault) {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "AZ Gain Def", BUT_OFF);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "AZ Gain Def", BUT_ON);
   }
 
-  // ALT Velocity Gain High
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (!oDriveExt.ALTgainHigh) {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "ALT Gain Hi", BUT_OFF);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "ALT Gain Hi", BUT_ON);
-  }
-
-  // ALT Velocity Gain Default
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (!oDriveExt.ALTgainDefault) {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "ALT Gain Def", BUT_OFF);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "ALT Gain Def", BUT_ON);
-  }
+  // ----- Column 3 -----
+  odriveLayout.drawButton(OD_AZ_GAIN_HI,   oDriveExt.AZgainHigh);
+  odriveLayout.drawButton(OD_AZ_GAIN_DEF,  oDriveExt.AZgainDefault);
+  odriveLayout.drawButton(OD_ALT_GAIN_HI,  oDriveExt.ALTgainHigh);
+  odriveLayout.drawButton(OD_ALT_GAIN_DEF, oDriveExt.ALTgainDefault);
 
-  //----------------------------------------
-  y_offset = 0;
-  // Demo Button
-  if (demoActive) {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "Demo Active", BUT_ON);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X + x_offset, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y - box_height_adj,
-                      "Demo ODrive", BUT_OFF);
-  }
+  odriveLayout.drawButton(OD_DEMO, demoActive);
 
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Reset ODrive Button
-  if (!resetODriveFlag) {
-    odriveButton.draw(OD_ACT_COL_3_X, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y, "Rst ODrive",
-                      BUT_OFF);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y, "Resetting", BUT_ON);
+  odriveLayout.drawButton(OD_RESET, resetODriveFlag);
+  if (resetODriveFlag) {
     resetODriveFlag = false;
     display._redrawBut = true;
   }
 
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Enable or Disable the ODrive position update via SERIAL
-  if (ODpositionUpdateEnabled) {
-    odriveButton.draw(OD_ACT_COL_3_X, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y, "Mtr Loop On",
-                      BUT_ON);
-  } else {
-    odriveButton.draw(OD_ACT_COL_3_X, OD_ACT_COL_3_Y + y_offset,
-                      OD_ACT_BOXSIZE_X, OD_ACT_BOXSIZE_Y, "Mtr Loop Off",
-                      BUT_OFF);
-  }
+  // ODrive position update via SERIAL or CAN
+  odriveLayout.drawButton(OD_MTR_LOOP, ODpositionUpdateEnabled);
 }
 
 // =========== ODrive button update ===========
 bool ODriveScreen::touchPoll(uint16_t px, uint16_t py) {
-  int x_offset = 0;
-  int y_offset = 0;
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-
-  // ===== Column 1 - Leftmost ======
-  // Enable Azimuth motor
-  if (px > OD_ACT_COL_1_X + x_offset &&
-      px < OD_ACT_COL_1_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_1_Y + y_offset &&
-      py < OD_ACT_COL_1_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    BEEP;
-    if (!axis1.isEnabled()) {                // if not On, toggle ON
-      digitalWrite(AZ_ENABLED_LED_PIN, LOW); // Turn On AZ LED
-      axis1.enable(true);
-    } else {                                  // since already ON, toggle OFF
-      digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZ LED
-      axis1.enable(false);
-    }
-    return true;
-  }
-
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Enable Altitude motor
-  if (px > OD_ACT_COL_1_X + x_offset &&
-      px < OD_ACT_COL_1_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_1_Y + y_offset &&
-      py < OD_ACT_COL_1_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    BEEP;
-    if (!axis2.isEnabled()) {                 // toggle ON
-      digitalWrite(ALT_ENABLED_LED_PIN, LOW); // Turn On ALT LED
-      axis2.enable(true);
-    } else {                                   // toggle OFF
-      digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn off ALT LED
-      axis2.enable(false);                     // turn off ODrive motor
-    }
-    return true;
-  }
-
-  // ----- Column 2 -----
-  // STOP everthing requested
-  y_offset = 0;
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  if (px > OD_ACT_COL_2_X + x_offset &&
-      px < OD_ACT_COL_2_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_2_Y + y_offset &&
-      py < OD_ACT_COL_2_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    BEEP;
-    if (!OdStopButton) {
-      commandBool(":Q#"); // stops move
-      axis1.enable(false);
-      axis2.enable(false);
-      OdStopButton = true;
-      digitalWrite(AZ_ENABLED_LED_PIN, HIGH);  // Turn Off AZ LED
-      digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
-      commandBool(":Td#");                     // Disable Tracking
-    }
-    return true;
-  }
-
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Clear ODrive Errors
-  if (px > OD_ACT_COL_2_X + x_offset &&
-      px < OD_ACT_COL_2_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_2_Y + y_offset &&
-      py < OD_ACT_COL_2_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    BEEP;
-    VLF("MSG: Clearing ODrive Errors");
-    oDriveExt.clearAllODriveErrors();
-    clearODriveErrs = true;
-    showODriveErrors();
-    return true;
-  }
-
-  // Column 3
-  y_offset = -165;
-  // AZ Gain HIGH
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y - box_height_adj) {
-    BEEP;
-    oDriveExt.AZgainHigh = true;
-    oDriveExt.AZgainDefault = false;
-    oDriveExt.setODriveVelGains(AZM_MOTOR, AZM_VEL_GAIN_HI,
-                                AZM_VEL_INT_GAIN_HI); // Set Velocity Gain
-    delay(1); // wait for ODrive to process change
-    showGains();
-    return true;
-  }
-
-  // AZ Gain DEFault
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y - box_height_adj) {
-    BEEP;
-    oDriveExt.AZgainHigh = false;
-    oDriveExt.AZgainDefault = true;
-    oDriveExt.setODriveVelGains(AZM_MOTOR, AZM_VEL_GAIN_DEF,
-                                AZM_VEL_INT_GAIN_DEF);
-    delay(1);
-    showGains();
-    return true;
-  }
-
-  // ALT Gain HIGH
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y - box_height_adj) {
-    BEEP;
-    oDriveExt.ALTgainHigh = true;
-    oDriveExt.ALTgainDefault = false;
-    oDriveExt.setODriveVelGains(
-        ALT_MOTOR, ALT_VEL_GAIN_HI,
-        ALT_VEL_INT_GAIN_HI); // Set Velocity Gain, Integrator gain
-    delay(1);
-    showGains();
-    return true;
-  }
-
-  // ALT Gain DEFault
-  y_offset += OD_ACT_BOXSIZE_Y - box_height_adj + OD_ACT_Y_SPACING;
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y - box_height_adj) {
-    BEEP;
-    oDriveExt.ALTgainHigh = false;
-    oDriveExt.ALTgainDefault = true;
-    oDriveExt.setODriveVelGains(ALT_MOTOR, ALT_VEL_GAIN_DEF,
-                                ALT_VEL_INT_GAIN_DEF);
-    delay(1);
-    showGains();
-    return true;
-  }
-
-  y_offset = 0;
-  // Demo Mode for ODrive
-  // Toggle on Demo Mode if button pressed, toggle off if pressed and already on
-  // Demo Mode bypasses OnStep control to repeat a sequence of moves
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    BEEP;
-    if (!demoActive) {
-      commandBool(":Q#"); // does not turn off Motor power
-      demoActive = true;
-
-      // Start demo task
-      VF("MSG: Setup, Demo Mode (rate 10 sec priority 6)... ");
-      uint8_t demoHandle = tasks.add(10000, 0, true, 6, demoWrapper, "Demo");
-      if (demoHandle) {
-        VLF("success");
+  switch (odriveLayout.hitTest(px, py)) {
+    // ===== Column 1 - Leftmost ======
+    case OD_EN_AZM: // Enable Azimuth motor
+      BEEP;
+      if (!axis1.isEnabled()) {                // if not On, toggle ON
+        digitalWrite(AZ_ENABLED_LED_PIN, LOW); // Turn On AZ LED
+        axis1.enable(true);
+      } else {                                  // since already ON, toggle OFF
+        digitalWrite(AZ_ENABLED_LED_PIN, HIGH); // Turn Off AZ LED
+        axis1.enable(false);
+      }
+      return true;
+
+    case OD_EN_ALT: // Enable Altitude motor
+      BEEP;
+      if (!axis2.isEnabled()) {                 // toggle ON
+        digitalWrite(ALT_ENABLED_LED_PIN, LOW); // Turn On ALT LED
+        axis2.enable(true);
+      } else {                                   // toggle OFF
+        digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn off ALT LED
+        axis2.enable(false);                     // turn off ODrive motor
+      }
+      return true;
+
+    // ----- Column 2 -----
+    case OD_STOP: // STOP everthing requested
+      BEEP;
+      if (!OdStopButton) {
+        commandBool(":Q#"); // stops move
+        axis1.enable(false);
+        axis2.enable(false);
+        OdStopButton = true;
+        digitalWrite(AZ_ENABLED_LED_PIN, HIGH);  // Turn Off AZ LED
+        digitalWrite(ALT_ENABLED_LED_PIN, HIGH); // Turn Off ALT LED
+        commandBool(":Td#");                     // Disable Tracking
+      }
+      return true;
+
+    case OD_CLR_ERRS: // Clear ODrive Errors
+      BEEP;
+      VLF("MSG: Clearing ODrive Errors");
+      oDriveExt.clearAllODriveErrors();
+      clearODriveErrs = true;
+      if (!plotActive) showODriveErrors();
+      return true;
+
+    // ----- Column 3 -----
+    case OD_AZ_GAIN_HI:
+      BEEP;
+      oDriveExt.AZgainHigh = true;
+      oDriveExt.AZgainDefault = false;
+      oDriveExt.setODriveVelGains(AZM_MOTOR, AZM_VEL_GAIN_HI,
+                                  AZM_VEL_INT_GAIN_HI); // Set Velocity Gain
+      delay(1); // wait for ODrive to process change
+      showGains();
+      return true;
+
+    case OD_AZ_GAIN_DEF:
+      BEEP;
+      oDriveExt.AZgainHigh = false;
+      oDriveExt.AZgainDefault = true;
+      oDriveExt.setODriveVelGains(AZM_MOTOR, AZM_VEL_GAIN_DEF,
+                                  AZM_VEL_INT_GAIN_DEF);
+      delay(1);
+      showGains();
+      return true;
+
+    case OD_ALT_GAIN_HI:
+      BEEP;
+      oDriveExt.ALTgainHigh = true;
+      oDriveExt.ALTgainDefault = false;
+      oDriveExt.setODriveVelGains(
+          ALT_MOTOR, ALT_VEL_GAIN_HI,
+          ALT_VEL_INT_GAIN_HI); // Set Velocity Gain, Integrator gain
+      delay(1);
+      showGains();
+      return true;
+
+    case OD_ALT_GAIN_DEF:
+      BEEP;
+      oDriveExt.ALTgainHigh = false;
+      oDriveExt.ALTgainDefault = true;
+      oDriveExt.setODriveVelGains(ALT_MOTOR, ALT_VEL_GAIN_DEF,
+                                  ALT_VEL_INT_GAIN_DEF);
+      delay(1);
+      showGains();
+      return true;
+
+    // Demo Mode for ODrive
+    // Toggle on Demo Mode if button pressed, toggle off if pressed and already on
+    // Demo Mode bypasses OnStep control to repeat a sequence of moves
+    case OD_DEMO:
+      BEEP;
+      if (!demoActive) {
+        commandBool(":Q#"); // does not turn off Motor power
+        demoActive = true;
+
+        // Start demo task
+        VF("MSG: Setup, Demo Mode (rate 10 sec priority 6)... ");
+        demoHandle = tasks.add(10000, 0, true, 6, demoWrapper, "Demo");
+        if (demoHandle) {
+          VLF("success");
+        } else {
+          VLF("FAILED!");
+        }
       } else {
-        VLF("FAILED!");
+        demoActive = false;
+        VLF("MSG: Demo OFF ODrive");
+        tasks.setDurationComplete(demoHandle);
       }
-    } else {
-      demoActive = false;
-      VLF("MSG: Demo OFF ODrive");
-      tasks.setDurationComplete(demoHandle);
-    }
-    return true;
+      return true;
+
+    case OD_RESET: // Reset ODRIVE
+      ALERT;
+      VLF("MSG: Resetting ODrive");
+      digitalWrite(ODRIVE_RST, LOW);
+      delay(1);
+      digitalWrite(ODRIVE_RST, HIGH);
+      delay(1000); // Wait for ODrive to boot
+      resetODriveFlag = true;
+      oDriveExt.AZgainHigh = false;
+      oDriveExt.AZgainDefault = true;
+      oDriveExt.ALTgainHigh = false;
+      oDriveExt.ALTgainDefault = true;
+      return true;
+
+    // Disable / Enable ODrive motor position update which uses SERIAL or CAN
+    // between ODrive and Teensy The purpose of Disable-position-updates so that
+    // they don't override the ODrive motor positions while tuning the ODrive and
+    // motors when using the ODrive USB serial port
+    case OD_MTR_LOOP:
+      ALERT;
+      if (ODpositionUpdateEnabled) { // on, then toggle off
+        axis1.enable(false);
+        axis2.enable(false);
+        ODpositionUpdateEnabled = false;
+      } else { // off, then toggle on
+        axis1.enable(true);
+        axis2.enable(true);
+        ODpositionUpdateEnabled = true;
+      }
+      return false;
   }
 
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  // Reset ODRIVE
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    ALERT;
-    VLF("MSG: Resetting ODrive");
-    digitalWrite(ODRIVE_RST, LOW);
-    delay(1);
-    digitalWrite(ODRIVE_RST, HIGH);
-    delay(1000); // Wait for ODrive to boot
-    // oDriveScreen.draw();
-    // ODRIVE_SERIAL.flush();
-    // oDriveExt.clearAllODriveErrors();
-    resetODriveFlag = true;
-    oDriveExt.AZgainHigh = false;
-    oDriveExt.AZgainDefault = true;
-    oDriveExt.ALTgainHigh = false;
-    oDriveExt.ALTgainDefault = true;
+#if defined(ENABLE_MOTOR_TELEMETRY) && ODRIVE_COMM_MODE == OD_CAN
+  // Tap the error list to plot the motors instead, tap the plot to go back
+  if (px > OD_PLOT_X && px < OD_PLOT_X + OD_PLOT_W && py > OD_ERR_OFFSET_Y && py < OD_PLOT_Y + OD_PLOT_H) {
+    BEEP;
+    plotActive = !plotActive;
+    if (plotActive) showPlot(); else showODriveErrors();
     return true;
   }
-
-  // Disable / Enable ODrive motor position update which uses SERIAL or CAN
-  // between ODrive and Teensy The purpose of Disable-position-updates so that
-  // they don't override the ODrive motor positions while tuning the ODrive and
-  // motors when using the ODrive USB serial port
-  y_offset += OD_ACT_BOXSIZE_Y + OD_ACT_Y_SPACING;
-  if (px > OD_ACT_COL_3_X + x_offset &&
-      px < OD_ACT_COL_3_X + x_offset + OD_ACT_BOXSIZE_X &&
-      py > OD_ACT_COL_3_Y + y_offset &&
-      py < OD_ACT_COL_3_Y + y_offset + OD_ACT_BOXSIZE_Y) {
-    ALERT;
-    if (ODpositionUpdateEnabled) { // on, then toggle off
-      axis1.enable(false);
-      axis2.enable(false);
-      ODpositionUpdateEnabled = false;
-    } else { // off, then toggle on
-      axis1.enable(true);
-      axis2.enable(true);
-      ODpositionUpdateEnabled = true;
-    }
-    return false;
-  }
+#endif
 
   // Check emergeyncy ABORT button area
   display.motorsOff(px, py);
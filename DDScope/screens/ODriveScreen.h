@@ -7,6 +7,7 @@
 #include <Arduino.h>
 #include "../display/Display.h"
 #include "../odriveExt/ODriveExt.h"
+#include "../odriveExt/MotorTelemetry.h"
 
 class Display;
 
@@ -17,18 +18,20 @@ class ODriveScreen : public Display {
     void updateOdriveStatus();
     void updateOdriveButtons();
     bool odriveButStateChange();
+    void drawPlot();
     
     
   private:
     void showODriveErrors();
     void showGains();
+    void showPlot();
+    void plotColumn(const MotorSample& s);
     uint8_t decodeODriveTopErrors(int axis, uint32_t errorCode, int y_offset);
     uint8_t decodeODriveAxisErrors(int axis, uint32_t errorCode, int y_offset);
     uint8_t decodeODriveMotorErrors(int axis, uint32_t errorCode, int y_offset);
     uint8_t decodeODriveContErrors(int axis, uint32_t errorCode, int y_offset);
     uint8_t decodeODriveEncErrors(int axis, uint32_t errorCode, int y_offset);
 
-    static const uint8_t box_height_adj = 10;
     bool demoActive       = false;
     bool clearODriveErrs  = false;
     bool resetODriveFlag  = false;
@@ -39,6 +42,13 @@ class ODriveScreen : public Display {
     int preAzmState       = 0;
     int preAltState       = 0;
     int demoHandle;
+
+    // motor telemetry plot in place of the error list
+    bool plotActive       = false;
+    uint8_t plotHandle    = 0;
+    uint32_t plotNext     = 0;  // next sample to draw
+    uint16_t plotX        = 0;  // its column
+    int16_t plotLastY[3][2];    // by band and ODrive axis
 };
 
 extern ODriveScreen oDriveScreen;
@@ -35,9 +35,9 @@ const char PlanetNames[8][8] = {"Mercury", "Venus", "Mars", "Jupiter", "Saturn",
 // Planets Screen Button object
 Button planetsButton(
                 0,0,0,0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 mainFontWidth, 
                 mainFontHeight, 
                 "");
@@ -79,7 +79,7 @@ void PlanetsScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Plant");
+  wifiDisplay.saveBufferToSD("Plant");
   #endif
 }
 
@@ -68,10 +68,10 @@
 #define FONT_Y_OFF 7
 
 // Catalog Button object default Arial
-Button shcCatDefButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, defFontWidth, defFontHeight, "");
+Button shcCatDefButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline, defFontWidth, defFontHeight, "");
 
 // Catalog Button object custom font
-Button shcCatButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+Button shcCatButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline, mainFontWidth, mainFontHeight, "");
 
 // Canvas Print object default Arial 6x9 font
 CanvasPrint canvShcDefPrint(display.default_font);
@@ -142,24 +142,20 @@ void SHCCatScreen::init(uint8_t catSelected) {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
 #endif
 #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD(title);
+  wifiDisplay.saveBufferToSD(title);
 #endif
 }
 
 //========= draw a Screen of SHC catalog data ===================
 //=== can consist of many screens of objects, so separate function
-void SHCCatScreen::drawShcCat() {
+// scroll = 0 redraws the list in place, NEXT (> 0) and BACK (< 0) bring the
+// new page in one row at a time through the hardware scroll area
+void SHCCatScreen::drawShcCat(int8_t scroll) {
   shcRow = 0;
   pre_shcIndex = 0;
-  #define CAT_DS_LINE_LENGTH (MAG_LENGTH + CONS_LENGTH + OBJTYPE_LENGTH + SUBID_LENGTH + 4 + 1)
-  char catLine[CAT_DS_LINE_LENGTH] = ""; // hold the string that is displayed beside the button on each page
-
-  //#define CAT_STAR_LINE_LENGTH (MAG_LENGTH + BAYER_LENGTH + CONS_LENGTH + OBJTYPE_LENGTH + 4 + 1)
-  //char catStLine[CAT_STAR_LINE_LENGTH] = ""; // hold the string that is displayed beside the button on each page
 
   // Show Page number and total Pages
   tft.fillRect(6, 9, 70, 12, butBackground);   // erase page numbers
-  tft.fillRect(2, 60, 317, 353, pgBackground); // clear lower screen
   tft.setFont(0);                              // basic Arial default
   tft.setCursor(6, 9);
   tft.print("Page ");
@@ -180,121 +176,156 @@ void SHCCatScreen::drawShcCat() {
   }
   shcLastRow = (cat_mgr.getMaxIndex() % NUM_CAT_ROWS_PER_SCREEN);
 
+  // read the rows of this page first, the rows on screen are not used while drawing
+  bool lastRow = false;
   while ((shcRow < NUM_CAT_ROWS_PER_SCREEN) || ((shcRow < shcLastRow) && shcLastPage)) {
-    // Page number and total Pages
-    tft.fillRect(8, 9, 70, 12, butBackground);
-    tft.setCursor(8, 9);
-    tft.print("Page ");
-    tft.print(shcCurrentPage + 1);
-    tft.print(" of ");
-    if (moreScreen.activeFilter)
-      tft.print("??");
-    else
-      tft.print((uint16_t)((cat_mgr.getMaxIndex() / NUM_CAT_ROWS_PER_SCREEN) + 1));
-
-    // erase any previous data
-    tft.setCursor(CAT_X + CAT_W + 2, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING));
-    tft.fillRect(CAT_X + CAT_W + 5, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING), 197, 17, butBackground);
-
-    // fill the button with some identifying text which varies depending on catalog chosen
-    memset(shcObjName[shcRow], '\0', OBJNAME_LENGTH);                    // NULL out row first
-    if (_catSelected == HERSCHEL || _catSelected == INDEX) { // use prefix and primaryId for these 2 catalogs
-      snprintf(shcObjName[shcRow], sizeof(shcObjName[shcRow]), "%2s%4ld", prefix, cat_mgr.primaryId());
-      // VF("priId="); VL(cat_mgr.primaryId());
-    } else if (cat_mgr.objectName() != -1) { // does it have a name
-      strncpy(shcObjName[shcRow], cat_mgr.objectNameStr(), sizeof(shcObjName[shcRow]) - 1);
-    } else if (cat_mgr.subId() != -1) { // does it have a subId
-      strncpy(shcObjName[shcRow], cat_mgr.subIdStr(), sizeof(shcObjName[shcRow]) - 1);
-      // VF("subId="); VL(cat_mgr.subIdStr());
-    } else {
-      strcpy(shcObjName[shcRow], "Unknown");
-    }
-    shcObjName[shcRow][sizeof(shcObjName[shcRow]) - 1] = '\0';  // Ensure null termination
-
-    shcCatDefButton.drawLJ(CAT_X, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING), CAT_W, CAT_H, shcObjName[shcRow], BUT_OFF);
-
-    // Object type e.g. Star, Galaxy, etc
-    memset(objTypeStr[shcRow], '\0', sizeof(objTypeStr[shcRow]));
-    strcpy(objTypeStr[shcRow], cat_mgr.objectTypeStr());
-
-    // Object SubId, e.g. N147, N7243
-    memset(shcSubId[shcRow], '\0', sizeof(shcSubId[shcRow]));
-    strcpy(shcSubId[shcRow], cat_mgr.subIdStr());
-
-    // Constellation
-    memset(shcCons[shcRow], '\0', sizeof(shcCons[shcRow]));
-    strcpy(shcCons[shcRow], cat_mgr.constellationStr());
-
-    // magnitude column
-    snprintf(shcMag[shcRow], sizeof(shcMag[shcRow]), "%4.1f", cat_mgr.magnitude());
-
-    // bayer and flamsteen
-    //memset(bayer[shcRow], '\0', sizeof(bayer[shcRow]));
-    // show the BayerFlamsteen number in the SubId field
-    if (!cat_mgr.isDsoCatalog()) {    // stars catalog
-      if (cat_mgr.bayerFlam() < 24) { // show greek letter names
-        strcpy(shcSubId[shcRow], Txt_Bayer[cat_mgr.bayerFlam()]);
-      } else { // just show Flamsteen number
-        strcpy(shcSubId[shcRow], cat_mgr.bayerFlamStr());
-      } 
+    loadShcRow(shcRow);
+
+    shcPrevRowIndex = cat_mgr.getIndex();
+    shcRow++;           // increments through the number of lines on screen
+    cat_mgr.incIndex(); // increment the index that keeps track of the entire catalog's contents
+
+    // stop reading data if last field on the last page
+    // VF("shcIndex="); VL(cat_mgr.getIndex());
+    // VF("shcPrevRowIndex="); VL(shcPrevRowIndex);
+    if ((shcPrevRowIndex >= cat_mgr.getIndex()) || (cat_mgr.getIndex() == cat_mgr.getMaxIndex())) {
+      shcEndOfList = true;
+      lastRow = true;
+      break;
     }
-    snprintf(catLine, 37, "%-4s| %-3s |%-14s |%-6s", 
-              shcMag[shcRow],
-              shcCons[shcRow],
-              objTypeStr[shcRow],
-              shcSubId[shcRow]);
-      // print out a line of data to the right of the object's button
-    tft.setCursor(CAT_X + CAT_W + SUB_STR_X_OFF, CAT_Y + shcRow * (CAT_H + CAT_Y_SPACING) + FONT_Y_OFF);
-    tft.print(catLine);
+  }
+  if (!lastRow) {
+    shcPagingArrayIndex[shcCurrentPage + 1] = cat_mgr.getIndex(); // shcPagingArrayIndex holds index of first element of page to help with NEXT and BACK paging
+    // VF("shcPagingArrayIndex+1="); VL(shcPagingArrayIndex[shcCurrentPage+1]);
+  }
+
+  // Page number and total Pages, refreshed once the page has been read
+  tft.fillRect(8, 9, 70, 12, butBackground);
+  tft.setCursor(8, 9);
+  tft.print("Page ");
+  tft.print(shcCurrentPage + 1);
+  tft.print(" of ");
+  if (moreScreen.activeFilter)
+    tft.print("??");
+  else
+    tft.print((uint16_t)((cat_mgr.getMaxIndex() / NUM_CAT_ROWS_PER_SCREEN) + 1));
+
+  if (scroll == 0) {
+    tft.fillRect(2, 60, 317, 353, pgBackground); // clear lower screen
+    for (uint16_t i = 0; i < shcRow; i++) drawShcRow(i, i);
+    return;
+  }
 
-    // Fill the RA array for this row on the current page
-    // RA in Hrs:Min:Sec
-    cat_mgr.raHMS(*shcRaHrs[shcRow], *shcRaMin[shcRow], *shcRaSec[shcRow]);
+  // Scroll a whole page, a row per step: NEXT exposes the bottom row and the
+  // page comes in top row first, BACK exposes the top row and goes the other
+  // way. After NUM_CAT_ROWS_PER_SCREEN steps the band is at rest again.
+  tft.setScrollArea(CAT_Y, NUM_CAT_ROWS_PER_SCREEN * (CAT_H + CAT_Y_SPACING));
+  for (uint16_t step = 0; step < NUM_CAT_ROWS_PER_SCREEN; step++) {
+    uint16_t i   = (scroll > 0) ? step : NUM_CAT_ROWS_PER_SCREEN - 1 - step;
+    uint16_t pos = (scroll > 0) ? NUM_CAT_ROWS_PER_SCREEN - 1 : 0;
+    tft.scrollArea((scroll > 0) ? (CAT_H + CAT_Y_SPACING) : -(CAT_H + CAT_Y_SPACING));
+    tft.fillRect(2, CAT_Y + pos * (CAT_H + CAT_Y_SPACING), 317, CAT_H + CAT_Y_SPACING, pgBackground);
+    if (i < shcRow) drawShcRow(i, pos);
+  }
+}
 
-    // shcRACustLine is used by the "Save to custom" catalog feature
-    snprintf(shcRACustLine[shcRow], 12, "%02u:%02u:%02u", (uint8_t)*shcRaHrs[shcRow], (uint8_t)*shcRaMin[shcRow], (uint8_t)*shcRaSec[shcRow]);
+// fill the arrays of one row from the current catalog index
+void SHCCatScreen::loadShcRow(uint16_t row) {
+  // fill the button with some identifying text which varies depending on catalog chosen
+  memset(shcObjName[row], '\0', OBJNAME_LENGTH);                    // NULL out row first
+  if (_catSelected == HERSCHEL || _catSelected == INDEX) { // use prefix and primaryId for these 2 catalogs
+    snprintf(shcObjName[row], sizeof(shcObjName[row]), "%2s%4ld", prefix, cat_mgr.primaryId());
+    // VF("priId="); VL(cat_mgr.primaryId());
+  } else if (cat_mgr.objectName() != -1) { // does it have a name
+    strncpy(shcObjName[row], cat_mgr.objectNameStr(), sizeof(shcObjName[row]) - 1);
+  } else if (cat_mgr.subId() != -1) { // does it have a subId
+    strncpy(shcObjName[row], cat_mgr.subIdStr(), sizeof(shcObjName[row]) - 1);
+    // VF("subId="); VL(cat_mgr.subIdStr());
+  } else {
+    strcpy(shcObjName[row], "Unknown");
+  }
+  shcObjName[row][sizeof(shcObjName[row]) - 1] = '\0';  // Ensure null termination
+
+  // Object type e.g. Star, Galaxy, etc
+  memset(objTypeStr[row], '\0', sizeof(objTypeStr[row]));
+  strcpy(objTypeStr[row], cat_mgr.objectTypeStr());
+
+  // Object SubId, e.g. N147, N7243
+  memset(shcSubId[row], '\0', sizeof(shcSubId[row]));
+  strcpy(shcSubId[row], cat_mgr.subIdStr());
+
+  // Constellation
+  memset(shcCons[row], '\0', sizeof(shcCons[row]));
+  strcpy(shcCons[row], cat_mgr.constellationStr());
+
+  // magnitude column
+  snprintf(shcMag[row], sizeof(shcMag[row]), "%4.1f", cat_mgr.magnitude());
+
+  // bayer and flamsteen
+  //memset(bayer[row], '\0', sizeof(bayer[row]));
+  // show the BayerFlamsteen number in the SubId field
+  if (!cat_mgr.isDsoCatalog()) {    // stars catalog
+    if (cat_mgr.bayerFlam() < 24) { // show greek letter names
+      strcpy(shcSubId[row], Txt_Bayer[cat_mgr.bayerFlam()]);
+    } else { // just show Flamsteen number
+      strcpy(shcSubId[row], cat_mgr.bayerFlamStr());
+    } 
+  }
 
-    // Create a temporary buffer to avoid overlap
-    char temp[10];
-    strncpy(temp, shcRACustLine[shcRow], 9);
+  // Fill the RA array for this row on the current page
+  // RA in Hrs:Min:Sec
+  cat_mgr.raHMS(*shcRaHrs[row], *shcRaMin[row], *shcRaSec[row]);
 
-    // Written to the controller for GoTo coordinates
-    snprintf(shcRaSrCmd[shcRow], 14, ":Sr%s#", temp);
+  // shcRACustLine is used by the "Save to custom" catalog feature
+  snprintf(shcRACustLine[row], 12, "%02u:%02u:%02u", (uint8_t)*shcRaHrs[row], (uint8_t)*shcRaMin[row], (uint8_t)*shcRaSec[row]);
 
-    // fill the DEC array for this Row on the current page
-    // DEC in Deg:Min:Sec
-    cat_mgr.decDMS(*shcDecDeg[shcRow], *shcDecMin[shcRow], *shcDecSec[shcRow]);
+  // Create a temporary buffer to avoid overlap
+  char temp[10];
+  strncpy(temp, shcRACustLine[row], 9);
 
-    // shcDECCustLine is used later by the "Save to custom catalog" feature
-    snprintf(shcDECCustLine[shcRow], 15, "%+03d*%02u:%02u", (int)*shcDecDeg[shcRow], (unsigned int)*shcDecMin[shcRow], (unsigned int)*shcDecSec[shcRow]);
+  // Written to the controller for GoTo coordinates
+  snprintf(shcRaSrCmd[row], 14, ":Sr%s#", temp);
 
-    // save the Alt and Azm for use later
-    cat_mgr.EquToHor(cat_mgr.ra(), cat_mgr.dec(), &shcAlt[shcRow], &shcAzm[shcRow]);
+  // fill the DEC array for this Row on the current page
+  // DEC in Deg:Min:Sec
+  cat_mgr.decDMS(*shcDecDeg[row], *shcDecMin[row], *shcDecSec[row]);
 
-    //Serial.printf("RA=%f, Dec=%f\n", cat_mgr.ra(), cat_mgr.dec());
-    //Serial.printf("Alt=%f, Azm=%f\n", shcAlt[shcRow], shcAzm[shcRow]);
+  // shcDECCustLine is used later by the "Save to custom catalog" feature
+  snprintf(shcDECCustLine[row], 15, "%+03d*%02u:%02u", (int)*shcDecDeg[row], (unsigned int)*shcDecMin[row], (unsigned int)*shcDecSec[row]);
 
-    // avoid possible overlapping regions
-    char bufTemp[12];
-    strncpy(bufTemp, shcDECCustLine[shcRow], sizeof(bufTemp) - 1);
-    bufTemp[sizeof(bufTemp) - 1] = '\0';
-    snprintf(shcDecSrCmd[shcRow], 16, ":Sd%s#", bufTemp);
-    // snprintf(shcDecSrCmd[shcRow], 16, ":Sd%s#", shcDECCustLine[shcRow]); // written to the controller for GoTo coordinates
+  // save the Alt and Azm for use later
+  cat_mgr.EquToHor(cat_mgr.ra(), cat_mgr.dec(), &shcAlt[row], &shcAzm[row]);
 
-    shcPrevRowIndex = cat_mgr.getIndex();
-    shcRow++;           // increments through the number of lines on screen
-    cat_mgr.incIndex(); // increment the index that keeps track of the entire catalog's contents
+  //Serial.printf("RA=%f, Dec=%f\n", cat_mgr.ra(), cat_mgr.dec());
+  //Serial.printf("Alt=%f, Azm=%f\n", shcAlt[row], shcAzm[row]);
 
-    // stop printing data if last field on the last page
-    // VF("shcIndex="); VL(cat_mgr.getIndex());
-    // VF("shcPrevRowIndex="); VL(shcPrevRowIndex);
-    if ((shcPrevRowIndex >= cat_mgr.getIndex()) || (cat_mgr.getIndex() == cat_mgr.getMaxIndex())) {
-      shcEndOfList = true;
-      return;
-    }
-  }
-  shcPagingArrayIndex[shcCurrentPage + 1] = cat_mgr.getIndex(); // shcPagingArrayIndex holds index of first element of page to help with NEXT and BACK paging
-  // VF("shcPagingArrayIndex+1="); VL(shcPagingArrayIndex[shcCurrentPage+1]);
+  // avoid possible overlapping regions
+  char bufTemp[12];
+  strncpy(bufTemp, shcDECCustLine[row], sizeof(bufTemp) - 1);
+  bufTemp[sizeof(bufTemp) - 1] = '\0';
+  snprintf(shcDecSrCmd[row], 16, ":Sd%s#", bufTemp);
+  // snprintf(shcDecSrCmd[row], 16, ":Sd%s#", shcDECCustLine[row]); // written to the controller for GoTo coordinates
+}
+
+// draw the button and data line of a row at screen row pos
+void SHCCatScreen::drawShcRow(uint16_t row, uint16_t pos) {
+  #define CAT_DS_LINE_LENGTH (MAG_LENGTH + CONS_LENGTH + OBJTYPE_LENGTH + SUBID_LENGTH + 4 + 1)
+  char catLine[CAT_DS_LINE_LENGTH] = ""; // hold the string that is displayed beside the button on each page
+  uint16_t y = CAT_Y + pos * (CAT_H + CAT_Y_SPACING);
+
+  // erase any previous data
+  tft.fillRect(CAT_X + CAT_W + 5, y, 197, 17, butBackground);
+
+  shcCatDefButton.drawLJ(CAT_X, y, CAT_W, CAT_H, shcObjName[row], BUT_OFF);
+
+  snprintf(catLine, 37, "%-4s| %-3s |%-14s |%-6s", 
+            shcMag[row],
+            shcCons[row],
+            objTypeStr[row],
+            shcSubId[row]);
+  // print out a line of data to the right of the object's button
+  tft.setCursor(CAT_X + CAT_W + SUB_STR_X_OFF, y + FONT_Y_OFF);
+  tft.print(catLine);
 }
 
 // show status changes on tasks timer tick
@@ -430,7 +461,7 @@ bool SHCCatScreen::touchPoll(uint16_t px, uint16_t py) {
     if (shcCurrentPage > 0) {
       shcEndOfList = false;
       shcCurrentPage--;
-      drawShcCat();
+      drawShcCat(-1);
     }
     return false;
   }
@@ -440,7 +471,7 @@ bool SHCCatScreen::touchPoll(uint16_t px, uint16_t py) {
     BEEP;
     if (!shcEndOfList) {
       shcCurrentPage++;
-      drawShcCat();
+      drawShcCat(1);
     }
     return false;
   }
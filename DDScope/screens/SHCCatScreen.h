@@ -24,7 +24,9 @@ class SHCCatScreen : public Display {
     
   private:
     void updateScreen();
-    void drawShcCat();
+    void drawShcCat(int8_t scroll = 0);
+    void loadShcRow(uint16_t row);
+    void drawShcRow(uint16_t row, uint16_t pos);
     void saveSHC();
     void writeSHCTarget(uint16_t index);
     void showTargetCoords();
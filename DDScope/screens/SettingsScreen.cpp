@@ -78,9 +78,9 @@
 // Settings Screen Button object
 Button settingsButton(
                 0, 0, 0, 0,
-                butOnBackground, 
-                butBackground, 
-                butOutline, 
+                &butOnBackground, 
+                &butBackground, 
+                &butOutline, 
                 mainFontWidth, 
                 mainFontHeight, 
                 "");
@@ -160,7 +160,7 @@ void SettingsScreen::draw() {
   wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
   #endif
   #ifdef ENABLE_TFT_CAPTURE
-  tft.saveBufferToSD("Settings");
+  wifiDisplay.saveBufferToSD("Settings");
   #endif
 } // end initialize
 
@@ -24,7 +24,7 @@
 #include "../screens/ODriveScreen.h"
 #endif
 
-// void touchWrapper() { touchScreen.touchScreenPoll(display.currentScreen); }
+// void touchWrapper() { touchScreen.touchScreenPoll(); }
 
 // Initialize Touchscreen
 void TouchScreen::init() {
@@ -39,46 +39,66 @@ void TouchScreen::init() {
 }
 
 bool externalTouch = false;
-// Poll the TouchScreen
-void TouchScreen::touchScreenPoll(ScreenEnum tCurScreen) {
-    
-//Serial.print((int)tCurScreen);
+
+// Add a touch to the queue, dropped if the queue is full
+bool TouchScreen::queueTouch(int16_t x, int16_t y, unsigned long ms, bool external) {
+  uint8_t next = (eventHead + 1) % TOUCH_QUEUE_EVENTS;
+  if (next == eventTail) return false;
+  events[eventHead].x = x;
+  events[eventHead].y = y;
+  events[eventHead].ms = ms;
+  events[eventHead].external = external;
+  eventHead = next;
+  return true;
+}
+
+// The XPT2046 library sets its IRQ flag from the TS_IRQ pin interrupt, so the
+// panel is only read over SPI while it is actually touched. A press counts
+// once the panel was released for TOUCH_DEBOUNCE_MS and repeats while held.
+void TouchScreen::collectTouches() {
+  unsigned long now = millis();
+
+  if (ts.tirqTouched() && ts.touched()) {
+    if (!pressed ? (now - releaseMs >= TOUCH_DEBOUNCE_MS) : (now - lastPressMs >= TOUCH_REPEAT_MS)) {
+      TS_Point raw = ts.getPoint();
+      // Scale from ~0->4000 to tft.width using the calibration #'s
+      // VF("x="); V(raw.x); VF(", y="); V(raw.y); VF(", z="); VL(raw.z); // for calibration
+      queueTouch(map(raw.x, TS_MINX, TS_MAXX, 0, tft.width()),
+                 map(raw.y, TS_MINY, TS_MAXY, 0, tft.height()), now, false);
+      lastPressMs = now;
+    }
+    pressed = true;
+  } else if (pressed) {
+    pressed = false;
+    releaseMs = now;
+  }
 
 #ifdef ENABLE_TFT_MIRROR
-  // Check for external touch input from ESP32-S3
-  if (SERIAL_ESP.available() >= 5) {
-    static String incoming = "";
-    char c = SERIAL_ESP.read();
-    if (c == 'T') {
-      uint16_t x = (SERIAL_ESP.read() << 8) | SERIAL_ESP.read();
-      uint16_t y = (SERIAL_ESP.read() << 8) | SERIAL_ESP.read();
-  
-      //SERIAL_DEBUG.printf("Received Touch at x=%u, y=%u\n", x, y);
-      if (x >= 0 && y >= 0) {
-        p.x = x;
-        p.y = y;
-        externalTouch = true;  // Mark as external touch to skip scaling
-        //SERIAL_DEBUG.printf("EX TOUCH: x=%d, y=%d\n", x, y);
-       }
-    } 
+  // touches from the web page, already in TFT pixels; espPoll() queues the
+  // TOUCH messages it receives
+  uint16_t x, y;
+  while (wifiDisplay.getTouch(x, y)) {
+    //SERIAL_DEBUG.printf("Received Touch at x=%u, y=%u\n", x, y);
+    queueTouch(x, y, now, true);
   }
 #endif
+}
 
-  if (externalTouch) {
-    // Process WiFi external touch without scaling (already scaled)
-    processTouch(tCurScreen);
-  } else if (ts.touched()) {  // Scale if TFT touch
-      p = ts.getPoint();
-      
-      // Scale from ~0->4000 to tft.width using the calibration #'s
-      // VF("x="); V(p.x); VF(", y="); V(p.y); VF(", z="); VL(p.z); // for
-      // calibration
-      p.x = map(p.x, TS_MINX, TS_MAXX, 0, tft.width());
-      p.y = map(p.y, TS_MINY, TS_MAXY, 0, tft.height());
-      // VF("x="); V(p.x); VF(", y="); V(p.y); VF(", z="); VL(p.z); //for
-      // calibration
-     
-      processTouch(tCurScreen);  // Handle the detected touch event
+// Poll the TouchScreen and dispatch queued touches to the current screen
+void TouchScreen::touchScreenPoll() {
+  collectTouches();
+
+  while (eventTail != eventHead) {
+    TouchEvent event = events[eventTail];
+    eventTail = (eventTail + 1) % TOUCH_QUEUE_EVENTS;
+
+    // queued behind a long screen draw, the screen it was meant for may be gone
+    if (millis() - event.ms > TOUCH_STALE_MS) continue;
+
+    p.x = event.x;
+    p.y = event.y;
+    externalTouch = event.external;  // external touches skip the capture window handling
+    processTouch(display.currentScreen);
   }
 }
 
@@ -152,6 +172,10 @@ void TouchScreen::processTouch(ScreenEnum tCurScreen) {
     break;
   }
 
+  // show the button feedback now instead of at the next status update, the
+  // WiFi mirror sends it as soon as the drawing settles
+  if (display.buttonTouched) display.refreshButtons();
+
   if (externalTouch) {
     externalTouch = false;
     wifiDisplay.enableScreenCapture(false);
@@ -6,14 +6,38 @@
 
 #include "../display/Display.h" 
 
+#define TOUCH_POLL_MS         5   // touch task rate, the XPT2046 IRQ flag is checked this often
+#define TOUCH_QUEUE_EVENTS   16
+#define TOUCH_DEBOUNCE_MS    40   // panel released at least this long before a new press counts
+#define TOUCH_REPEAT_MS     250   // a held press repeats at this rate, like the old poll did
+#define TOUCH_STALE_MS     1000   // events older than this when dispatched are dropped
+
+typedef struct TouchEvent {
+  int16_t       x;          // TFT pixels
+  int16_t       y;
+  unsigned long ms;         // when it happened
+  bool          external;   // from the WiFi mirror web page
+} TouchEvent;
+
 class TouchScreen {
   public:
     void init();
-    void touchScreenPoll(ScreenEnum tCurScreen);
+    void touchScreenPoll();
     void processTouch(ScreenEnum tCurScreen);
     
   private:
+    void collectTouches();
+    bool queueTouch(int16_t x, int16_t y, unsigned long ms, bool external);
+
     ScreenEnum tCurScreen = HOME_SCREEN;
+
+    TouchEvent    events[TOUCH_QUEUE_EVENTS];
+    uint8_t       eventHead = 0;
+    uint8_t       eventTail = 0;
+
+    bool          pressed = false;       // panel held down
+    unsigned long lastPressMs = 0;       // last press queued, for the repeat
+    unsigned long releaseMs = 0;         // when the panel was let go
 };
 
 extern TouchScreen touchScreen;
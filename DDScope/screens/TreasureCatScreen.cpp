@@ -48,10 +48,10 @@
 
 
 // Catalog Button object for default Arial font
-Button treasureDefButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, defFontWidth, defFontHeight, "");
+Button treasureDefButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline, defFontWidth, defFontHeight, "");
 
 // Catalog Button object for custom font
-Button treasureCatButton(0, 0, 0, 0, butOnBackground, butBackground, butOutline, mainFontWidth, mainFontHeight, "");
+Button treasureCatButton(0, 0, 0, 0, &butOnBackground, &butBackground, &butOutline, mainFontWidth, mainFontHeight, "");
 
 // Canvas Print object default Arial 6x9 font
 CanvasPrint canvTreasureDefPrint(display.default_font);
@@ -162,10 +162,12 @@ void TreasureCatScreen::parseTcatIntoArray() {
 // ========== draw TREASURE page of catalog data ========
 // TREASURE Catalog takes different processing than SmartHandController Catalogs
 // since it is stored on the SD card in a different format
-void TreasureCatScreen::drawTreasureCat() {
+// scroll = 0 redraws the list in place, NEXT (> 0) and BACK (< 0) bring the
+// new page in one row at a time through the hardware scroll area
+void TreasureCatScreen::drawTreasureCat(int8_t scroll) {
   tRow = 0;
   pre_tAbsIndex=0;
-  char catLine[47]=""; //hold the string that is displayed beside the button on each page
+  bool lastRow = false;
   
   tAbsRow = (tPagingArrayIndex[tCurrentPage]); // array of page 1st row indexes
   tLastPage = ((MAX_TREASURE_ROWS / NUM_CAT_ROWS_PER_SCREEN)+1);
@@ -174,7 +176,6 @@ void TreasureCatScreen::drawTreasureCat() {
 
   // Show Page number and total Pages
   tft.fillRect(6, 9, 77, 32,  butBackground); // erase page numbers
-  tft.fillRect(2,60,317,353, pgBackground); // clear lower screen
   tft.setFont(0); // basic Arial font
   tft.setCursor(6, 9); 
   tft.print("Page "); 
@@ -240,33 +241,6 @@ void TreasureCatScreen::drawTreasureCat() {
     
     // filter out elements below 10 deg if filter enabled
     if (((moreScreen.activeFilter == FM_ABOVE_HORIZON) && (dtAlt[tAbsRow] > 10.0)) || moreScreen.activeFilter == FM_NONE) { 
-     
-      // Erase text background
-      tft.setCursor(CAT_X+CAT_W+2, CAT_Y+tRow*(CAT_H+CAT_Y_SPACING));
-      tft.fillRect(CAT_X+CAT_W+5, CAT_Y+tRow*(CAT_H+CAT_Y_SPACING), 197, 17,  butBackground);
-
-      // get object names and put them on the buttons
-      treasureDefButton.drawLJ(CAT_X, CAT_Y+tRow*(CAT_H+CAT_Y_SPACING), CAT_W, CAT_H, tArray[tAbsRow].tSubId, BUT_OFF);
-                  
-      // format and print the text field for this row next to the button
-      // FYI: mod1_treasure.csv file field order and spacing: 7;8;7;4;9;4;9;18 = 66 total w/out semicolons, 73 with ;'s
-      // Char number does not include null terminator
-      // 7 - objName
-      // 8 - RA
-      // 7 - DEC
-      // 4 - Cons
-      // 9 - ObjType
-      // 4 - Mag
-      // 9 - Size ( Not used )
-      //18 - SubId
-      // select some Treasure fields to show beside button
-      snprintf(catLine, sizeof(catLine), "%-4s |%-4s |%-9s |%-18s",  //35 + 6 + NULL = 42
-                                          tArray[tAbsRow].tMag, 
-                                          tArray[tAbsRow].tCons, 
-                                          tArray[tAbsRow].tObjType, 
-                                          tArray[tAbsRow].tObjName);
-      tft.setCursor(CAT_X+CAT_W+SUB_STR_X_OFF, CAT_Y+tRow*(CAT_H+CAT_Y_SPACING)+FONT_Y_OFF); 
-      tft.print(catLine);
       tFiltArray[tRow] = tAbsRow;
       //VF("tFiltArray[tRow]="); VL(tFiltArray[tRow]);
       tRow++; // increments only through the number of lines displayed on screen per page
@@ -275,15 +249,67 @@ void TreasureCatScreen::drawTreasureCat() {
     tPrevRowIndex = tAbsRow;
     tAbsRow++; // increments through all lines in the catalog
     
-    // stop printing data if last row on the last page
+    // stop reading data if last row on the last page
     if (tAbsRow == MAX_TREASURE_ROWS) {
       tEndOfList = true; 
-      if (tRow == 0) {canvTreasureInsPrint.printRJ(STATUS_STR_X, STATUS_STR_Y, STATUS_STR_W, STATUS_STR_H, "None above 10 deg", false);}
-      return; 
+      lastRow = true;
+      break; 
+    }
+  }
+  if (!lastRow) {
+    tPagingArrayIndex[tCurrentPage+1] = tAbsRow; // tPagingArrayIndex holds index of first element of page to help with NEXT and BACK paging
+    //VF("tPagingArrayIndex+1="); VL(tPagingArrayIndex[tCurrentPage+1]);
+  }
+
+  if (scroll == 0) {
+    tft.fillRect(2,60,317,353, pgBackground); // clear lower screen
+    for (uint16_t i = 0; i < tRow; i++) drawTreasureRow(i, i);
+  } else {
+    // a row per step, see SHCCatScreen::drawShcCat()
+    tft.setScrollArea(CAT_Y, NUM_CAT_ROWS_PER_SCREEN*(CAT_H+CAT_Y_SPACING));
+    for (uint16_t step = 0; step < NUM_CAT_ROWS_PER_SCREEN; step++) {
+      uint16_t i   = (scroll > 0) ? step : NUM_CAT_ROWS_PER_SCREEN-1-step;
+      uint16_t pos = (scroll > 0) ? NUM_CAT_ROWS_PER_SCREEN-1 : 0;
+      tft.scrollArea((scroll > 0) ? (CAT_H+CAT_Y_SPACING) : -(CAT_H+CAT_Y_SPACING));
+      tft.fillRect(2, CAT_Y+pos*(CAT_H+CAT_Y_SPACING), 317, CAT_H+CAT_Y_SPACING, pgBackground);
+      if (i < tRow) drawTreasureRow(i, pos);
     }
   }
-  tPagingArrayIndex[tCurrentPage+1] = tAbsRow; // tPagingArrayIndex holds index of first element of page to help with NEXT and BACK paging
-  //VF("tPagingArrayIndex+1="); VL(tPagingArrayIndex[tCurrentPage+1]);
+
+  if (lastRow && tRow == 0) {canvTreasureInsPrint.printRJ(STATUS_STR_X, STATUS_STR_Y, STATUS_STR_W, STATUS_STR_H, "None above 10 deg", false);}
+}
+
+// draw the button and data line of a page row at screen row pos
+void TreasureCatScreen::drawTreasureRow(uint16_t row, uint16_t pos) {
+  char catLine[47]=""; //hold the string that is displayed beside the button on each page
+  uint16_t absRow = tFiltArray[row];
+  uint16_t y = CAT_Y+pos*(CAT_H+CAT_Y_SPACING);
+
+  // Erase text background
+  tft.fillRect(CAT_X+CAT_W+5, y, 197, 17,  butBackground);
+
+  // get object names and put them on the buttons
+  treasureDefButton.drawLJ(CAT_X, y, CAT_W, CAT_H, tArray[absRow].tSubId, BUT_OFF);
+              
+  // format and print the text field for this row next to the button
+  // FYI: mod1_treasure.csv file field order and spacing: 7;8;7;4;9;4;9;18 = 66 total w/out semicolons, 73 with ;'s
+  // Char number does not include null terminator
+  // 7 - objName
+  // 8 - RA
+  // 7 - DEC
+  // 4 - Cons
+  // 9 - ObjType
+  // 4 - Mag
+  // 9 - Size ( Not used )
+  //18 - SubId
+  // select some Treasure fields to show beside button
+  snprintf(catLine, sizeof(catLine), "%-4s |%-4s |%-9s |%-18s",  //35 + 6 + NULL = 42
+                                      tArray[absRow].tMag, 
+                                      tArray[absRow].tCons, 
+                                      tArray[absRow].tObjType, 
+                                      tArray[absRow].tObjName);
+  tft.setCursor(CAT_X+CAT_W+SUB_STR_X_OFF, y+FONT_Y_OFF); 
+  tft.print(catLine);
 }
 
 // show status changes on tasks timer tick
@@ -418,7 +444,7 @@ bool TreasureCatScreen::touchPoll(uint16_t px, uint16_t py) {
       tPrevPage = tCurrentPage;
       tEndOfList = false;
       tCurrentPage--;
-      drawTreasureCat();
+      drawTreasureCat(-1);
     }
     return false;
   }
@@ -429,7 +455,7 @@ bool TreasureCatScreen::touchPoll(uint16_t px, uint16_t py) {
     if (!tEndOfList) {
       tPrevPage = tCurrentPage;
       tCurrentPage++;
-      drawTreasureCat();
+      drawTreasureCat(1);
     }
     return false;
   }
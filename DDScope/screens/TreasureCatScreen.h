@@ -37,7 +37,8 @@ class TreasureCatScreen : public Display {
     void updateScreen();
     bool loadTreasureArray();
     void parseTcatIntoArray();
-    void drawTreasureCat();
+    void drawTreasureCat(int8_t scroll = 0);
+    void drawTreasureRow(uint16_t row, uint16_t pos);
     void saveTreasure();
     void writeTreasureTarget(uint16_t index);
     void showTargetCoords();
@@ -0,0 +1,68 @@
+// =====================================================
+// HostDisplay.h
+// Stands in for Display.h, UsbBridge.h, SdWriter.h and DrawRecorder.h when
+// WifiDisplay.cpp and EspLoopback.cpp are built on the PC
+//
+// Included ahead of every source file (-include), so the include guards
+// below keep the real headers, and with them OnStepX and the TFT driver,
+// out of the build. The mirror runs as configured in Display.h except for
+// ENABLE_TFT_DRAWCMDS, whose replay needs Adafruit_GFX.
+
+#ifndef HOST_DISPLAY_H
+#define HOST_DISPLAY_H
+
+#define DISPLAY_H
+#define USB_BRIDGE_H
+#define SD_WRITER_H
+#define DRAW_RECORDER_H
+
+#define ENABLE_TFT_MIRROR
+#define ENABLE_TFT_TILES
+#define ENABLE_TFT_ADAPTIVE
+#define ENABLE_TFT_PAL_FRAMES
+#define ENABLE_ESP_LOOPBACK
+
+#define SERIAL_DEBUG Serial
+
+#include <Arduino.h>
+#include "../DDScope/display/WifiDisplay.h"
+#include "../DDScope/display/EspLoopback.h"
+
+#define SERIAL_ESP espLoopback
+
+// menu bar, where the loopback touches
+#define MENU_X              3
+#define MENU_Y             46
+#define MENU_X_SPACING     81
+#define MENU_BOXSIZE_X     72
+#define MENU_BOXSIZE_Y     45
+
+// showIp() draws on the home screen, which the test never shows
+typedef enum { HOME_SCREEN, HOST_SCREEN } ScreenEnum;
+
+class Display {
+  public:
+    static ScreenEnum currentScreen;
+};
+
+class HostTft {
+  public:
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {}
+    void setCursor(int16_t x, int16_t y) {}
+    void print(const char *s) {}
+};
+
+class SdWriter {
+  public:
+    bool isRecording() { return false; }
+    bool recordFrame(uint8_t codec, bool delta, const uint8_t *data, uint32_t len) { return true; }
+    bool isBackedUp() { return false; }
+    bool saveScreen(const char *fileName, const uint8_t *frame, uint32_t len) { return false; }
+};
+
+extern Display display;
+extern HostTft tft;
+extern SdWriter sdWriter;
+extern uint16_t butBackground;
+
+#endif
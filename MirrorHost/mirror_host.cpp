@@ -0,0 +1,128 @@
+// =====================================================
+// mirror_host.cpp
+// The WiFi mirror link on the PC: WifiDisplay.cpp against the fake ESP32-S3
+// in EspLoopback.cpp, without a Teensy, an ESP32-S3 or a web client
+//
+// Screens are drawn straight into the capture buffer, like the TFT driver
+// does. After each step the peer's copy of the screen has to match what was
+// drawn. The peer may see CRC errors only on the frames the test corrupts on
+// purpose, and each of those has to cost one RESYNC and a keyframe. Exits
+// with 1 when anything doesn't add up.
+
+#include <Arduino.h>
+
+uint32_t hostMicros = 0;
+HostSerial Serial;
+ScreenEnum Display::currentScreen = HOST_SCREEN;
+Display display;
+HostTft tft;
+SdWriter sdWriter;
+uint16_t butBackground = 0;
+
+extern volatile bool espReady;
+static WifiDisplay wifiDisplay;
+
+static uint32_t corrupted = 0; // frames corrupted on purpose
+static uint16_t failures = 0;
+
+// the espPoll task, once per ms
+static void runMs(uint32_t ms) {
+  while (ms--) {
+    hostMicros += 1000;
+    wifiDisplay.espPoll();
+  }
+}
+
+// ======== Drawing ========
+static void fillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+  for (uint16_t row = y; row < y + h; row++) {
+    uint8_t *p = captureBuffer + (row * SCREEN_WIDTH + x) * COLOR_DEPTH;
+    for (uint16_t col = 0; col < w; col++) { *p++ = color >> 8; *p++ = color & 0xFF; }
+  }
+  wifiDisplay.markDirty(x, y, x + w - 1, y + h - 1);
+}
+
+// flat fills, buttons and lines of "text", like most screens
+static void drawScreen(uint16_t seed) {
+  fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0x0000);
+  fillRect(0, 0, SCREEN_WIDTH, 44, 0x8800 + seed);
+  for (uint16_t b = 0; b < 4; b++) fillRect(MENU_X + b * MENU_X_SPACING, MENU_Y, MENU_BOXSIZE_X, MENU_BOXSIZE_Y, 0x2104);
+  for (uint16_t line = 0; line < 20; line++) {
+    for (uint16_t c = 0; c < 30; c++) {
+      if ((c * 7 + line * 3 + seed) % 5) fillRect(8 + c * 10, 110 + line * 18, 6, 10, 0xFA00 + line);
+    }
+  }
+}
+
+// noise, too many colors for palette frames
+static void drawPicture(uint32_t seed) {
+  for (uint16_t y = 120; y < 360; y++) {
+    for (uint16_t x = 0; x < SCREEN_WIDTH; x++) {
+      seed = seed * 1664525UL + 1013904223UL;
+      fillRect(x, y, 1, 1, seed >> 16);
+    }
+  }
+}
+
+// a button that changes on a touch
+static void drawButton(uint16_t n) {
+  fillRect(MENU_X + (n % 4) * MENU_X_SPACING, MENU_Y, MENU_BOXSIZE_X, MENU_BOXSIZE_Y, 0x07E0 + n);
+}
+
+// ======== Checks ========
+static void check(const char *step, bool ok) {
+  if (ok) return;
+  printf("FAIL: %s\n", step);
+  failures++;
+}
+
+// Ask for a frame and let the link run until it is through, then compare
+static void pushFrame(const char *step) {
+  wifiDisplay.sendFrameToEsp(FRAME_TYPE_DEF);
+  runMs(2000);
+  check(step, memcmp(espLoopback.screen(), captureBuffer, UNCOMPRESSED_BUFFER_SIZE) == 0);
+}
+
+int main() {
+  // HELLO, HELLO_ACK, IP_REQUEST, IP, ACK, CLIENT, then the first keyframe
+  for (uint16_t ms = 0; !espReady && ms < 5000; ms++) runMs(1);
+  check("handshake", espReady);
+  if (!espReady) return 1;
+  runMs(2000);
+  check("first keyframe", espLoopback.keyframeCount() == 1 &&
+        memcmp(espLoopback.screen(), captureBuffer, UNCOMPRESSED_BUFFER_SIZE) == 0);
+
+  uint32_t keyframes = espLoopback.keyframeCount();
+  drawScreen(0);
+  pushFrame("new screen");
+  check("new screen is a keyframe", espLoopback.keyframeCount() == keyframes + 1);
+
+  // button presses go as tile deltas, with a keyframe every TILE_KEYFRAME_FRAMES
+  uint32_t deltas = espLoopback.deltaCount();
+  for (uint16_t n = 0; n < 2 * TILE_KEYFRAME_FRAMES; n++) {
+    drawButton(n);
+    pushFrame("button delta");
+  }
+  check("deltas", espLoopback.deltaCount() > deltas);
+
+  // a bad frame costs one RESYNC and a keyframe, which go through the keyframe
+  // codecs as the adaptive selection measures them
+  for (uint16_t n = 0; n < 12; n++) {
+    uint32_t resyncs = espLoopback.resyncCount();
+    keyframes = espLoopback.keyframeCount();
+    if (n % 3 == 2) drawPicture(n);
+    else if (n % 3 == 1) drawScreen(n);
+    drawButton(n);
+    espLoopback.corruptNextFrame();
+    corrupted++;
+    pushFrame("resync keyframe");
+    check("resync", espLoopback.resyncCount() == resyncs + 1);
+    check("keyframe after resync", espLoopback.keyframeCount() > keyframes);
+  }
+
+  check("errors", espLoopback.errorCount() == corrupted);
+  printf("mirror_host: %u keyframes, %u deltas, %u resyncs, %u errors, %u failed checks\n",
+         (unsigned)espLoopback.keyframeCount(), (unsigned)espLoopback.deltaCount(),
+         (unsigned)espLoopback.resyncCount(), (unsigned)espLoopback.errorCount(), failures);
+  return failures ? 1 : 0;
+}
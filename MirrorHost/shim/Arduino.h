@@ -0,0 +1,71 @@
+// =====================================================
+// Arduino.h
+// Host stand-in for the parts of the Teensy core the mirror link uses
+//
+// Time doesn't pass on its own: the test moves hostMicros forward, so link
+// rates and timeouts behave the same on every run.
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#define EXTMEM
+#define DMAMEM
+
+extern uint32_t hostMicros;
+inline uint32_t micros() { return hostMicros; }
+inline unsigned long millis() { return hostMicros / 1000; }
+
+template <class T> inline T min(T a, T b) { return a < b ? a : b; }
+template <class T> inline T max(T a, T b) { return a > b ? a : b; }
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while (n < size && write(buffer[n])) n++;
+      return n;
+    }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+    size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+    size_t println(const char *s) { return print(s) + print("\n"); }
+    size_t println() { return print("\n"); }
+    size_t printf(const char *format, ...) {
+      char buf[256];
+      va_list args;
+      va_start(args, format);
+      int n = vsnprintf(buf, sizeof(buf), format, args);
+      va_end(args);
+      return (n > 0) ? print(buf) : 0;
+    }
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+// debug output goes to stdout
+class HostSerial : public Stream {
+  public:
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    size_t write(uint8_t c) { return fputc(c, stdout) == EOF ? 0 : 1; }
+    using Print::write;
+};
+
+extern HostSerial Serial;
+
+#endif
@@ -0,0 +1,8 @@
+// =====================================================
+// SD.h
+// Host stand-in, the mirror test doesn't write the SD card
+
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#endif
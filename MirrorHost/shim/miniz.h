@@ -0,0 +1,53 @@
+// =====================================================
+// miniz.h
+// Host stand-in for the miniz calls of the mirror link, on top of zlib
+//
+// Same raw deflate streams and CRC-32 as miniz on the Teensy.
+
+#ifndef HOST_MINIZ_H
+#define HOST_MINIZ_H
+
+#define ZLIB_CONST
+#include <zlib.h>
+#include <stddef.h>
+
+typedef z_stream mz_stream;
+
+#define MZ_OK                   Z_OK
+#define MZ_STREAM_END           Z_STREAM_END
+#define MZ_NO_FLUSH             Z_NO_FLUSH
+#define MZ_FINISH               Z_FINISH
+#define MZ_DEFLATED             Z_DEFLATED
+#define MZ_DEFAULT_WINDOW_BITS  15
+#define MZ_BEST_SPEED           Z_BEST_SPEED
+#define MZ_DEFAULT_COMPRESSION  Z_DEFAULT_COMPRESSION
+#define MZ_CRC32_INIT           0
+
+inline int mz_deflateInit2(mz_stream *stream, int level, int method, int windowBits, int memLevel, int strategy) {
+  return deflateInit2(stream, level, method, windowBits, memLevel, strategy);
+}
+inline int mz_deflate(mz_stream *stream, int flush) { return deflate(stream, flush); }
+inline int mz_deflateEnd(mz_stream *stream) { return deflateEnd(stream); }
+
+inline unsigned long mz_crc32(unsigned long crc, const unsigned char *ptr, size_t len) {
+  return crc32(crc, ptr, (uInt)len);
+}
+
+// raw deflate (flags 0) into a buffer of outLen bytes
+#define TINFL_DECOMPRESS_MEM_TO_MEM_FAILED ((size_t)(-1))
+
+inline size_t tinfl_decompress_mem_to_mem(void *out, size_t outLen, const void *in, size_t inLen, int flags) {
+  (void)flags;
+  z_stream stream = {};
+  if (inflateInit2(&stream, -MZ_DEFAULT_WINDOW_BITS) != Z_OK) return TINFL_DECOMPRESS_MEM_TO_MEM_FAILED;
+  stream.next_in = (const Bytef *)in;
+  stream.avail_in = (uInt)inLen;
+  stream.next_out = (Bytef *)out;
+  stream.avail_out = (uInt)outLen;
+  int status = inflate(&stream, Z_FINISH);
+  size_t n = stream.total_out;
+  inflateEnd(&stream);
+  return (status == Z_STREAM_END) ? n : TINFL_DECOMPRESS_MEM_TO_MEM_FAILED;
+}
+
+#endif
@@ -0,0 +1,8 @@
+// =====================================================
+// OnTask.h
+// Host stand-in, the mirror test calls the poll functions itself
+
+#ifndef HOST_ONTASK_H
+#define HOST_ONTASK_H
+
+#endif
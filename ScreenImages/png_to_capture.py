@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+# png_to_capture.py
+#
+# Turn the screen images in this folder back into TFT captures for the
+# mirror codec benchmark (DDScope/display/MirrorBench.h): 320x480 pixels,
+# big-endian RGB565, 307200 bytes, the format saveBufferToSD() writes.
+#
+# usage: python3 png_to_capture.py [png files...] [-o output dir]
+#        copy the tft_<screen>_log.bin files to the SD card root
+
+import argparse
+import glob
+import os
+import struct
+
+from PIL import Image
+
+WIDTH = 320
+HEIGHT = 480
+
+
+def convert(png_path, out_dir):
+    img = Image.open(png_path).convert("RGB")
+    if img.size != (WIDTH, HEIGHT):
+        print(f"skipped {png_path}: {img.size[0]}x{img.size[1]}, not {WIDTH}x{HEIGHT}")
+        return
+    data = bytearray()
+    for r, g, b in img.getdata():
+        data += struct.pack(">H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+    name = os.path.splitext(os.path.basename(png_path))[0]
+    if not name.startswith("tft_"):
+        name = "tft_" + name
+    if not name.endswith("_log"):
+        name += "_log"
+    out_path = os.path.join(out_dir, name + ".bin")
+    with open(out_path, "wb") as f:
+        f.write(data)
+    print(f"{png_path} -> {out_path}")
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="PNG screen images to RGB565 TFT captures")
+    parser.add_argument("images", nargs="*", help="PNG files, default all in ScreenImages/")
+    parser.add_argument("-o", "--out", default=".", help="output directory")
+    args = parser.parse_args()
+
+    images = args.images or sorted(glob.glob(os.path.join(here, "*.png")))
+    os.makedirs(args.out, exist_ok=True)
+    for path in images:
+        convert(path, args.out)
+
+
+if __name__ == "__main__":
+    main()